@@ -0,0 +1,53 @@
+#include "Chronometro.hpp"
+#include <coroutine>
+#include <iostream>
+#include <thread>
+
+// minimal coroutine type, started eagerly and never awaited
+struct Task
+{
+  struct promise_type
+  {
+    Task get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+// resumes the awaiting coroutine on a new thread after 'milliseconds'
+struct Wait
+{
+  unsigned milliseconds;
+  std::thread* resumer;
+
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> coroutine)
+  {
+    *resumer = std::thread([coroutine, delay = milliseconds]{ stz::sleep(delay); coroutine.resume(); });
+  }
+  void await_resume() const noexcept {}
+};
+
+Task serve(std::thread* resumer)
+{
+  stz::Span span;
+
+  stz::sleep(2);                          // active
+  co_await span(Wait{20, &resumer[0]});   // suspended, resumed on another thread
+  stz::sleep(3);                          // active
+  co_await span(Wait{30, &resumer[1]});   // suspended
+  stz::sleep(1);                          // active
+
+  std::cout << span.times() << '\n'; // prints ~"active 6.0 ms, suspended 50.0 ms over 2 suspensions"
+}
+
+int main()
+{
+  std::thread resumer[2];
+  serve(resumer);
+
+  resumer[0].join();
+  resumer[1].join();
+}
@@ -1,7 +1,13 @@
 #define STZ_NOT_THREADSAFE
+#define CHRONOMETRO_TRACK_ALLOCATIONS // must be defined in only one translation unit
 #include "Chronometro.hpp"
+#include <algorithm>
 #include <iostream>
 #include <cstring>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <vector>
 
 int main()
 {
@@ -115,4 +121,166 @@ int main()
 
     stz::sleep(std::chrono::microseconds(1));
   }
+
+  std::cout << '\n';
+  static unsigned data[1 << 16] = {};
+  stz::Measure cold_measure(10, "", "cold cache: average iteration took %Dus");
+  cold_measure.flush(data, sizeof(data)); // data is flushed out of the caches before each iteration (not measured)
+  for (auto iteration : cold_measure)
+  {
+    for (auto& element : data) element += iteration.value; // measured
+  }
+
+  std::cout << '\n';
+  std::vector<std::vector<unsigned>> inputs(10);
+  stz::Measure sort_measure(10, "", "sorting: average iteration took %Dus");
+  // fresh unsorted copies, prepared 5 iterations at a time (not measured)
+  sort_measure.prepare(5, [&](unsigned first, unsigned count)
+  {
+    for (unsigned index = first; index < first + count; ++index)
+    {
+      inputs[index].resize(1000);
+      for (unsigned element = 0; element < 1000; ++element) inputs[index][element] = (element * 7919u) % 1000;
+    }
+  });
+  sort_measure.teardown([&](unsigned index){ inputs[index].clear(); }); // not measured
+  for (auto iteration : sort_measure)
+  {
+    std::sort(inputs[iteration.value].begin(), inputs[iteration.value].end()); // only this is measured
+  }
+
+  std::cout << '\n';
+  for (const auto& placement : stz::numa_sweep(std::size_t(16) << 20, 3)) // every cpu node to every memory node
+  {
+    std::cout << placement << '\n'; // latency and bandwidth, with their penalty relative to the local node
+  }
+  stz::NumaBuffer remote(sizeof(data), stz::numa_nodes() - 1); // bound with mbind(), without libnuma
+  stz::Measure numa_measure(10, "", "last node's memory from node 0: average iteration took %Dus");
+  numa_measure.numa(0, stz::numa_nodes() - 1); // allocations made during the run are bound to the node as well
+  for (auto iteration : numa_measure)
+  {
+    for (std::size_t k = 0; k < remote.size(); k += 64) remote.data()[k] += static_cast<char>(iteration.value);
+  }
+
+  std::cout << '\n';
+  stz::measure_block(3, "iteration %# took %us and allocated %bytes", "%Dallocs allocations per iteration")
+  {
+    std::string text(64, 'x'); // measured, allocates once
+  };
+
+  std::cout << '\n';
+  std::string text(1000, 'x');
+  stz::compare(100,
+    [&]{ std::string copy = text; },        // baseline
+    [&]{ const std::string& view = text; (void)view; }
+  ); // prints each variant's statistics and its speedup relative to the baseline
+
+  std::cout << '\n';
+  stz::isolate_block(3, 10) // 3 forked processes of 10 iterations each
+  {
+    std::string copy = text; // measured in each child process
+  }; // prints per-process statistics, then variance between and within processes
+
+  std::cout << '\n';
+  unsigned ticks = 0;
+  stz::loop_at_rate(std::chrono::milliseconds(10))
+  {
+    stz::sleep(2); // time spent in the body does not make the deadlines drift
+    if (++ticks == 20) stz::break_now;
+  };
+
+  std::cout << '\n';
+  stz::TimerWheel wheel;
+  unsigned maintenance = 0;
+  wheel.every(std::chrono::milliseconds(20), [&]{ ++maintenance; });
+  wheel.after(std::chrono::milliseconds(100), [&]{ std::cout << "maintenance ran " << maintenance << " times\n"; });
+  stz::loop_at_rate(std::chrono::milliseconds(1))
+  {
+    wheel.poll(); // a single clock read, however many timers are registered
+    if (wheel.size() == 1) stz::break_now;
+  };
+
+  std::cout << '\n';
+  stz::Budget budget(std::chrono::milliseconds(5)); // keeps the 16 slowest scopes exceeding 5 ms
+  for (unsigned request = 0; request < 10; ++request)
+  {
+    stz::Budget::Scope scope(budget); // a single clock read and compare on exit when under budget
+    auto parse = scope.zone("parse");
+    stz::sleep(request % 4 == 0 ? 6 : 1);
+  }
+  budget.report(); // prints the captured scopes with their zone breakdown
+
+  std::cout << '\n';
+  stz::Accumulator accumulator; // may be shared by many threads, each adding to its own shard
+  for (unsigned request = 0; request < 5; ++request)
+  {
+    stz::Stopwatch request_stopwatch;
+    stz::sleep(request);
+    accumulator.add(request_stopwatch.split());
+  }
+  const auto accumulated = accumulator.snapshot();
+  std::cout << accumulated.count << " requests, max " << accumulated.max.count() << " ns\n";
+
+  std::cout << '\n';
+  stz::LiveMetric requests("requests"); // keeps the last 60 seconds in one-second histograms
+  {
+    stz::Reporter reporter(std::chrono::milliseconds(100)); // prints 1 s, 10 s and 60 s windows every 100 ms
+    reporter.add(requests);
+    for (unsigned request = 0; request < 200; ++request)
+    {
+      stz::Stopwatch request_stopwatch;
+      stz::sleep(request % 10 == 0 ? 5 : 1);
+      requests.record(request_stopwatch.split()); // lock held only to bump one histogram bucket
+    }
+  } // the reporter thread is stopped and joined here
+
+  std::cout << '\n';
+  stz::SharedMetrics shared("CHZ.metrics"); // watch it live with: CHZ_monitor CHZ.metrics
+  auto lookups = shared.metric("lookups");
+  for (unsigned lookup = 0; lookup < 100; ++lookup)
+  {
+    stz::Stopwatch lookup_stopwatch;
+    stz::sleep(std::chrono::microseconds(10));
+    lookups.record(lookup_stopwatch.split()); // no system call, lock or formatting
+    lookups.count();
+  }
+  for (const auto& metric : stz::SharedMetrics::read("CHZ.metrics"))
+  {
+    std::cout << metric.name << ": " << metric.count << " durations, p99 " << metric.p99.count() << " ns\n";
+  }
+
+  std::cout << '\n';
+  stz::TimedMutex queue_mutex("queue"); // a drop-in replacement for std::mutex
+  {
+    std::thread producer([&]
+    {
+      for (unsigned item = 0; item < 100; ++item)
+      {
+        std::lock_guard<stz::TimedMutex> lock(queue_mutex);
+        stz::sleep(std::chrono::microseconds(20)); // held
+      }
+    });
+    for (unsigned item = 0; item < 100; ++item)
+    {
+      std::lock_guard<stz::TimedMutex> lock(queue_mutex); // waited for while the producer holds it
+    }
+    producer.join();
+  }
+  queue_mutex.report(); // prints acquisitions, contentions, and wait and hold times
+
+  std::cout << '\n';
+  for (const auto& clock : stz::characterize_clocks())
+  {
+    std::cout << clock << '\n'; // resolution, read cost, monotonicity and cross-cpu consistency
+  }
+  // must happen before RuntimeClock is first read, which would otherwise select with a 100 ns precision
+  std::cout << "selected " << stz::select_clock(std::chrono::microseconds(1)) << '\n';
+  const auto clock_start = stz::RuntimeClock::now(); // define CHRONOMETRO_CLOCK as stz::RuntimeClock to use it everywhere
+  stz::sleep(1);
+  std::cout << "slept " << (stz::RuntimeClock::now() - clock_start).count() << " ns\n";
+
+  std::cout << '\n';
+  stz::Instrument<stz::Level::fine>::Stopwatch fine_stopwatch; // a stand-in without clock reads below CHRONOMETRO_LEVEL 2
+  stz::sleep(3);
+  std::cout << fine_stopwatch.split(); // prints ~"elapsed time: 3000 us", or "elapsed time: 0 ns" when disabled
 }
@@ -35,20 +35,67 @@ blocks and more. See the included README.MD file for more information.
 #define _chronometro_hpp
 #if __cplusplus >= 201103L
 //---necessary standard libraries---------------------------------------------------------------------------------------
-#include <chrono>    // for std::chrono::steady_clock, std::chrono::high_resolution_clock, std::chrono::nanoseconds
-#include <ostream>   // for std::ostream
-#include <iostream>  // for std::cout, std::endl
-#include <string>    // for std::string, std::to_string
-#include <utility>   // for std::move
-#include <cstdio>    // for std::sprintf
-#include <exception> // for std::exception
+#include <chrono>      // for std::chrono::steady_clock, std::chrono::high_resolution_clock, std::chrono::nanoseconds
+#include <ostream>     // for std::ostream, std::endl
+#include <string>      // for std::string, std::to_string
+#include <utility>     // for std::move
+#include <cstdio>      // for std::sprintf
+#include <exception>   // for std::exception
+#include <cstddef>     // for std::size_t
+#include <cstdint>     // for std::uintptr_t
+#include <cstdlib>     // for std::strtoull, std::strtoul, std::strtod, std::malloc, std::free
+#include <cstring>     // for std::strlen, std::strncmp, std::strcmp
+#include <memory>      // for std::unique_ptr
+#include <vector>      // for std::vector
+#include <new>         // for std::bad_alloc, std::nothrow_t
+#include <algorithm>   // for std::shuffle, std::sort, std::min, std::max
+#include <random>      // for std::minstd_rand
+#include <cmath>       // for std::sqrt, std::log, std::exp
+#include <type_traits> // for std::conditional, std::remove_reference, std::is_void, std::is_same
+#include <functional>  // for std::function
+#include <ctime>       // for std::time_t, std::tm, std::strftime, std::localtime
+#include <atomic>      // for std::atomic, std::atomic_thread_fence
+#include <limits>      // for std::numeric_limits
 //---conditionally necessary standard libraries-------------------------------------------------------------------------
-#if not defined(CHRONOMETRO_CLOCK)
-# include <type_traits> // for std::conditional
+#if not defined(CHRONOMETRO_LEVEL)
+# define CHRONOMETRO_LEVEL 3
+#endif
+#if CHRONOMETRO_LEVEL > 0
+# include <iostream> // for std::cout, std::clog, std::cerr
 #endif
 #if defined(__STDCPP_THREADS__) and not defined(CHRONOMETRO_NOT_THREADSAFE)
 # define  _stz_impl_THREADSAFE
-# include <mutex> // for std::mutex, std::lock_guard
+# include <mutex>  // for std::mutex, std::lock_guard, std::unique_lock
+# include <thread> // for std::thread, std::this_thread::sleep_for, std::this_thread::yield
+# include <condition_variable> // for std::condition_variable
+#endif
+#if defined(__unix__)
+# include <unistd.h>   // for sysconf, usleep, fork, pipe, read, write, close, getpid, _exit
+# include <sys/wait.h> // for waitpid
+# include <fcntl.h>    // for open, O_RDWR, O_RDONLY, O_CREAT
+# include <sys/mman.h> // for mmap, munmap
+# include <sys/stat.h> // for fstat
+# include <sys/file.h> // for flock
+# include <signal.h>   // for kill
+# include <pthread.h>  // for pthread_atfork
+# include <cerrno>     // for errno, ESRCH
+#endif
+#if defined(_WIN32)
+# include <malloc.h> // for _aligned_malloc, _aligned_free
+#endif
+#if defined(__linux__)
+# include <sched.h> // for sched_setaffinity, sched_getaffinity, sched_getcpu, cpu_set_t
+# include <time.h>  // for clock_gettime, CLOCK_MONOTONIC_RAW, CLOCK_MONOTONIC_COARSE
+# include <sys/syscall.h> // for SYS_mbind, SYS_get_mempolicy, SYS_set_mempolicy
+#endif
+#if (__cplusplus >= 202002L) and defined(__cpp_impl_coroutine)
+# define  _stz_impl_COROUTINES
+# include <coroutine> // for std::coroutine_handle
+#endif
+#if (defined(__x86_64__) or defined(__i386__)) and (defined(__GNUC__) or defined(__clang__))
+# define  _stz_impl_TSC
+# include <x86intrin.h> // for __rdtsc
+# include <cpuid.h>     // for __get_cpuid
 #endif
 //*///------------------------------------------------------------------------------------------------------------------
 namespace stz
@@ -56,15 +103,178 @@ namespace stz
 inline namespace chronometro
 //*///------------------------------------------------------------------------------------------------------------------
 {
+  // instrumentation levels, CHRONOMETRO_LEVEL selects the highest one compiled (3 by default)
+  enum class Level
+  {
+    off,    // 0: no instrumentation, io streams discard their output and <iostream> is not included,
+            //    if_elapsed bodies NEVER run: keep statements the program relies on out of them
+    coarse, // 1: measure_block, if_elapsed, and sites of that level
+    fine,   // 2: sites of that level and below
+    trace   // 3: every site
+  };
+
+  // Stopwatch, Measure and Budget::Scope of 'level', or stand-ins compiling to nothing if it is not enabled
+  template<Level level>
+  struct Instrument;
+
   // measures the time it takes to execute statements
 # define measure_block(...) // must be followed by '{ statements... };'
 
+  // measures the time it takes to execute statements in separate forked processes, which start from the parent's
+  // state and address space layout, only shifted by random heap and stack padding; a child that throws is discarded
+# define isolate_block(...) // must be followed by '{ statements... };'
+
   // measure elapsed time
   class Stopwatch;
 
   // measure iterations via range-based for-loop
   class Measure;
 
+  // regulate a loop to a fixed rate against absolute deadlines
+  class Regulator;
+
+  // drive many periodic and one-shot callbacks from a hierarchical timing wheel
+  class TimerWheel;
+
+  // capture the slowest scopes exceeding a latency budget
+  class Budget;
+
+  // accumulate durations from many threads without contending on a shared cache line
+  class Accumulator;
+
+  // windowed statistics over the last 1 s, 10 s and 60 s of recorded durations
+  class LiveMetric;
+
+#if defined(_stz_impl_THREADSAFE)
+  // publish LiveMetric snapshots at a fixed interval from a background thread, only available with threads
+  class Reporter;
+#endif
+
+  // expose durations and counters in a memory-mapped file readable by another process
+  class SharedMetrics;
+
+#if defined(_stz_impl_THREADSAFE)
+  // mutex measuring how long it is waited for and held, only available with threads
+  class TimedMutex;
+#endif
+
+#if defined(_stz_impl_COROUTINES)
+  // attribute a coroutine's time to running and to awaiting, across threads
+  class Span;
+#endif
+
+  // cache state enforced before each Measure iteration
+  enum class Cache
+  {
+    warm,  // leave the caches as the previous iteration left them
+    evict, // stream over a buffer larger than the last level cache
+    flush  // flush the registered buffers out of the cache hierarchy
+  };
+
+  // cache hierarchy detected on the host, in bytes
+  struct CacheSizes
+  {
+    std::size_t l1d;
+    std::size_t l2;
+    std::size_t l3;
+    std::size_t line;
+  };
+
+  // detected cache hierarchy
+  inline auto cache_sizes() noexcept -> const CacheSizes&;
+
+  // host conditions that can make measurements unreliable
+  struct Environment
+  {
+    int      cpu;          // cpu the thread runs on, -1 if unknown
+    char     governor[32]; // frequency governor of that cpu, empty if unknown
+    int      turbo;        // 1 if turbo is enabled, 0 if disabled, -1 if unknown
+    double   sibling_load; // busy fraction of the SMT siblings of that cpu, -1 if unknown or none
+    double   load_average; // 1-minute load average, -1 if unknown
+    unsigned cpus;         // online cpus
+  };
+
+  // probe the environment of 'cpu', or of the calling thread's cpu if negative
+  inline auto environment(int cpu = -1) noexcept -> Environment;
+
+  // report probed environment
+  inline std::ostream& operator<<(std::ostream& ostream, const Environment& environment) noexcept;
+
+  // online NUMA nodes, 1 where NUMA is not supported
+  inline auto numa_nodes() noexcept -> unsigned;
+
+  // pin the calling thread to the cpus of NUMA 'node', false if it has none or could not be pinned
+  inline auto pin_to_node(unsigned node) noexcept -> bool;
+
+  // latency and bandwidth of the memory of one NUMA node as seen from the cpus of another
+  struct NumaPlacement
+  {
+    unsigned cpu_node;
+    unsigned memory_node;
+    bool     bound;             // memory was bound to 'memory_node', instead of placed by the default policy
+    double   latency;           // nanoseconds per dependent load, chased in random order
+    double   bandwidth;         // bytes per nanosecond of sequential reads
+    double   latency_penalty;   // latency relative to that of the cpu node's local memory
+    double   bandwidth_penalty; // bandwidth of the cpu node's local memory relative to this bandwidth
+  };
+
+  // measure every combination of cpu node and memory node over buffers of 'size' bytes, best of 'rounds'
+  inline auto numa_sweep(std::size_t size = std::size_t(64) << 20, unsigned rounds = 5) -> std::vector<NumaPlacement>;
+
+  // report placement
+  inline std::ostream& operator<<(std::ostream& ostream, const NumaPlacement& placement) noexcept;
+
+  // clock sources RuntimeClock can be dispatched to
+  enum class Clock
+  {
+    steady,           // std::chrono::steady_clock
+    high_resolution,  // std::chrono::high_resolution_clock
+    monotonic_raw,    // CLOCK_MONOTONIC_RAW, not slewed by NTP
+    monotonic_coarse, // CLOCK_MONOTONIC_COARSE, cheap but only ticks at the scheduler rate
+    tsc               // invariant time stamp counter, calibrated against std::chrono::steady_clock
+  };
+
+  // characteristics of a clock source measured on the host
+  struct ClockCharacteristics
+  {
+    Clock                    clock;
+    const char*              name;
+    bool                     available;
+    std::chrono::nanoseconds resolution; // smallest step observed between two reads
+    double                   read_cost;  // average nanoseconds per read
+    bool                     monotonic;  // steady, and never observed going backwards
+    bool                     consistent; // never observed going backwards when migrating between cpus
+  };
+
+  // characterize every clock source of the host
+  inline auto characterize_clocks() -> std::vector<ClockCharacteristics>;
+
+  // dispatch RuntimeClock to the cheapest monotonic and consistent source resolving 'precision'
+  inline auto select_clock(std::chrono::nanoseconds precision = std::chrono::nanoseconds(100)) -> ClockCharacteristics;
+
+  // report characteristics
+  inline std::ostream& operator<<(std::ostream& ostream, const ClockCharacteristics& characteristics) noexcept;
+
+  // steady clock dispatched at runtime, selected on first read unless select_clock() was called beforehand;
+  // Stopwatch, Measure and sleep() use it when CHRONOMETRO_CLOCK is defined as stz::RuntimeClock
+  // WARNING: selecting characterizes every clock, which blocks the first now() for up to a hundred milliseconds
+  // and migrates the calling thread across cpus, call init() or select_clock() at startup to keep that off the
+  // measurements
+  struct RuntimeClock
+  {
+    using rep        = std::chrono::nanoseconds::rep;
+    using period     = std::chrono::nanoseconds::period;
+    using duration   = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<RuntimeClock>;
+
+    static constexpr bool is_steady = true;
+
+    static inline auto now() noexcept -> time_point;
+
+    // select the source now() dispatches to as its first read would, does nothing if already selected
+    static inline void init() noexcept;
+  };
+
   // units in which time obtained from Stopwatch can
   // be displayed and in which sleep() be slept with.
   enum class Unit
@@ -86,12 +296,21 @@ inline namespace chronometro
   template<typename R = std::chrono::milliseconds::rep, typename P = std::chrono::milliseconds::period>
   void sleep(std::chrono::duration<R, P> duration) noexcept;
 
+  // measure 'bodies' in interleaved randomized order, report their speedups relative to the first,
+  // stopping after the last complete round if a body breaks
+  template<typename... L>
+  void compare(unsigned rounds, L&&... bodies);
+
   // execute statements if last execution was atleast 'DURATION' prior
+  // WARNING: with CHRONOMETRO_LEVEL 0 the statements are compiled but NEVER executed, it is an instrumentation site
 # define if_elapsed(DURATION) // must be followed by '{ statements... };'
 
   // execute statements 'N' times
 # define loop_n_times(N) // must be followed by '{ statements... };'
 
+  // execute statements once every 'PERIOD', until broken out of, then report overruns, jitter and frequency
+# define loop_at_rate(PERIOD) // must be followed by '{ statements... };'
+
   // execute statements every 'N' encounters
 # define if_n_pass(N) // must be followed by '{ statements... };'
 
@@ -176,14 +395,22 @@ inline namespace chronometro
 #   define _stz_impl_NODISCARD_REASON(REASON) _stz_impl_NODISCARD
 # endif
 
+// support from clang 3.9.0 and GCC 4.7.3 onward
+# if defined(__clang__) or defined(__GNUC__)
+#   define _stz_impl_NOINLINE __attribute__((noinline))
+# else
+#   define _stz_impl_NOINLINE
+# endif
+
 #if defined(_stz_impl_THREADSAFE)
-# undef  _stz_impl_THREADSAFE
 # define _stz_impl_THREADLOCAL         thread_local
 # define _stz_impl_DECLARE_MUTEX(...)  static std::mutex __VA_ARGS__
+# define _stz_impl_MEMBER_MUTEX(...)   mutable std::mutex __VA_ARGS__;
 # define _stz_impl_DECLARE_LOCK(MUTEX) std::lock_guard<decltype(MUTEX)> _lock(MUTEX)
 #else
 # define _stz_impl_THREADLOCAL
 # define _stz_impl_DECLARE_MUTEX(...)
+# define _stz_impl_MEMBER_MUTEX(...)
 # define _stz_impl_DECLARE_LOCK(MUTEX)
 #endif
 
@@ -241,65 +468,125 @@ inline namespace chronometro
     _stz_impl_MAKE_UNIT_HELPER_SPECIALIZATION(Unit::h,   "h",   3600000000000);
 #   undef _stz_impl_MAKE_UNIT_HELPER_SPECIALIZATION
 
-    template<Unit unit, unsigned n_decimals>
-    auto _time_as_cstring(const _time<unit, n_decimals> time_) noexcept -> const char*
+    // render 'nanoseconds_' in units of 'factor_' with integer fixed-point arithmetic, 'buffer_' holds atleast 32 chars
+    inline auto _write_time(
+      char* const buffer_, const std::int64_t nanoseconds_, const unsigned long long factor_, const char* label_,
+      const unsigned n_decimals_
+    ) noexcept -> std::size_t
     {
-      static _stz_impl_THREADLOCAL char buffer[32];
+      static const std::uint64_t scales[] = {1, 10, 100, 1000, 10000};
 
-      const double ajusted_time = static_cast<double>(time_.nanoseconds.count()) * _unit_helper<unit>::ifactor;
+      char* cursor = buffer_;
 
-      std::sprintf(buffer,
-        (n_decimals == 0) ? "%.0f %s"
-      : (n_decimals == 1) ? "%.1f %s"
-      : (n_decimals == 2) ? "%.2f %s"
-      : (n_decimals == 3) ? "%.3f %s"
-      :                     "%.4f %s",
-      ajusted_time, _unit_helper<unit>::label);
+      // negated in unsigned arithmetic so that the minimum value does not overflow
+      auto magnitude = static_cast<std::uint64_t>(nanoseconds_);
+      if (nanoseconds_ < 0)
+      {
+        *cursor++ = '-';
+        magnitude = 0 - magnitude;
+      }
 
-      return buffer;
+      const unsigned n_decimals = (n_decimals_ < 4) ? n_decimals_ : 4;
+      const std::uint64_t scale = scales[n_decimals];
+
+      // the remainder is below 'factor_', atmost an hour, so rounding it at 4 decimals cannot overflow
+      auto whole    = magnitude/factor_;
+      auto fraction = (2*(magnitude % factor_)*scale + factor_)/(2*factor_);
+      if (fraction == scale)
+      {
+        ++whole;
+        fraction = 0;
+      }
+
+      char digits[20];
+      unsigned n_digits = 0;
+      do
+      {
+        digits[n_digits++] = static_cast<char>('0' + whole % 10);
+        whole /= 10;
+      } while (whole);
+
+      while (n_digits) *cursor++ = digits[--n_digits];
+
+      if (n_decimals)
+      {
+        *cursor++ = '.';
+        for (unsigned k = n_decimals; k--;)
+        {
+          cursor[k] = static_cast<char>('0' + fraction % 10);
+          fraction /= 10;
+        }
+        cursor += n_decimals;
+      }
+
+      *cursor++ = ' ';
+      while (*label_) *cursor++ = *label_++;
+      *cursor = '\0';
+
+      return static_cast<std::size_t>(cursor - buffer_);
+    }
+
+    template<Unit unit, unsigned n_decimals>
+    auto _write_time(char* const buffer_, const _time<unit, n_decimals> time_) noexcept -> std::size_t
+    {
+      return _write_time(buffer_, time_.nanoseconds.count(), _unit_helper<unit>::factor, _unit_helper<unit>::label,
+        n_decimals);
     }
 
     template<unsigned n_decimals>
-    auto _time_as_cstring(const _time<Unit::automatic, n_decimals> time_) noexcept -> const char*
+    auto _write_time(char* const buffer_, const _time<Unit::automatic, n_decimals> time_) noexcept -> std::size_t
     {
       // 10 h < duration
       if _stz_impl_ABNORMAL(time_.nanoseconds.count() > 36000000000000)
       {
-        return _time_as_cstring(_time<Unit::h, n_decimals>{time_.nanoseconds});
+        return _write_time(buffer_, _time<Unit::h, n_decimals>{time_.nanoseconds});
       }
 
       // 10 min < duration <= 10 h
       if _stz_impl_ABNORMAL(time_.nanoseconds.count() > 600000000000)
       {
-        return _time_as_cstring(_time<Unit::min, n_decimals>{time_.nanoseconds});
+        return _write_time(buffer_, _time<Unit::min, n_decimals>{time_.nanoseconds});
       }
 
       // 10 s < duration <= 10 m
       if (time_.nanoseconds.count() > 10000000000)
       {
-        return _time_as_cstring(_time<Unit::s, n_decimals>{time_.nanoseconds});
+        return _write_time(buffer_, _time<Unit::s, n_decimals>{time_.nanoseconds});
       }
 
       // 10 ms < duration <= 10 s
       if (time_.nanoseconds.count() > 10000000)
       {
-        return _time_as_cstring(_time<Unit::ms, n_decimals>{time_.nanoseconds});
+        return _write_time(buffer_, _time<Unit::ms, n_decimals>{time_.nanoseconds});
       }
 
       // 10 us < duration <= 10 ms
       if (time_.nanoseconds.count() > 10000)
       {
-        return _time_as_cstring(_time<Unit::us, n_decimals>{time_.nanoseconds});
+        return _write_time(buffer_, _time<Unit::us, n_decimals>{time_.nanoseconds});
       }
 
       // duration <= 10 us
-      return _time_as_cstring(_time<Unit::ns, n_decimals>{time_.nanoseconds});
+      return _write_time(buffer_, _time<Unit::ns, n_decimals>{time_.nanoseconds});
+    }
+
+    template<Unit unit, unsigned n_decimals>
+    auto _time_as_cstring(const _time<unit, n_decimals> time_) noexcept -> const char*
+    {
+      static _stz_impl_THREADLOCAL char buffer[32];
+
+      _write_time(buffer, time_);
+
+      return buffer;
     }
 
     template<Unit unit, unsigned n_decimals>
     std::ostream& operator<<(std::ostream& ostream_, const _time<unit, n_decimals> time_) noexcept
     {
-      return ostream_ << "elapsed time: " << _chronometro_impl::_time_as_cstring(time_) << std::endl;
+      char buffer[32];
+      const auto length = _write_time(buffer, time_);
+
+      return ostream_.write("elapsed time: ", 14).write(buffer, static_cast<std::streamsize>(length)).put('\n');
     }
 
     template<Unit unit, unsigned n_decimals>
@@ -307,12 +594,20 @@ inline namespace chronometro
     {
       constexpr const char* specifiers[] = {"%ms", "%us", "%s", "%ns", "%min", "%h"};
 
+      char        text[32];
+      std::size_t length = 0;
+
       for (const std::string specifier : specifiers)
       {
         auto position = fmt_.rfind(specifier);
         while (position != std::string::npos)
         {
-          fmt_.replace(position, specifier.length(), _time_as_cstring(time_));
+          if (length == 0)
+          {
+            length = _write_time(text, time_);
+          }
+
+          fmt_.replace(position, specifier.length(), text, length);
           position = fmt_.find(specifier);
         }
       }
@@ -320,9 +615,93 @@ inline namespace chronometro
       return std::move(fmt_);
     }
 
-    template<Unit unit, unsigned n_decimals>
-    auto _split_fmt(const _time<unit, n_decimals> time_, std::string&& fmt_, const unsigned iter_) noexcept
+    // heap activity of the calling thread, counted by the CHRONOMETRO_TRACK_ALLOCATIONS hooks
+    struct _allocations final
+    {
+      unsigned long long allocs;
+      unsigned long long frees;
+      unsigned long long bytes;
+
+      auto operator-(const _allocations& other_) const noexcept -> _allocations
+      {
+        return {allocs - other_.allocs, frees - other_.frees, bytes - other_.bytes};
+      }
+
+      void operator+=(const _allocations& other_) noexcept
+      {
+        allocs += other_.allocs;
+        frees  += other_.frees;
+        bytes  += other_.bytes;
+      }
+    };
+
+    inline auto _allocation_counters() noexcept -> _allocations&
+    {
+      static _stz_impl_THREADLOCAL _allocations counters = {};
+      return counters;
+    }
+
+    inline auto _allocation_hooks() noexcept -> bool&
+    {
+      static bool installed = false;
+      return installed;
+    }
+
+    inline auto _format_allocations(const _allocations& counts_, std::string&& fmt_, const unsigned n_iters_) noexcept
       -> std::string
+    {
+      struct
+      {
+        const char*        specifier;
+        unsigned long long count;
+        const char*        label;
+      } const specifiers[] = {
+        {"%allocs", counts_.allocs, ""},
+        {"%frees",  counts_.frees,  ""},
+        {"%bytes",  counts_.bytes,  " B"}
+      };
+
+      for (const auto& specifier : specifiers)
+      {
+        const std::size_t length = std::strlen(specifier.specifier);
+
+        auto position = fmt_.rfind(specifier.specifier);
+        if (position == std::string::npos) continue;
+
+        if _stz_impl_ABNORMAL(not _allocation_hooks())
+        {
+          static std::atomic<bool> warned(false);
+          if (not warned.exchange(true, std::memory_order_relaxed))
+          {
+            io::wrn() << "stz: Measure: allocations are only counted when CHRONOMETRO_TRACK_ALLOCATIONS is defined "
+              "in one translation unit" << std::endl;
+          }
+        }
+
+        char text[48];
+        if (n_iters_ <= 1)
+        {
+          std::sprintf(text, "%llu%s", specifier.count, specifier.label);
+        }
+        else
+        {
+          std::sprintf(text, "%.2f%s", static_cast<double>(specifier.count)/n_iters_, specifier.label);
+        }
+
+        while (position != std::string::npos)
+        {
+          fmt_.replace(position, length, text);
+          position = fmt_.find(specifier.specifier);
+        }
+      }
+
+      return std::move(fmt_);
+    }
+
+    template<Unit unit, unsigned n_decimals>
+    auto _split_fmt(
+      const _time<unit, n_decimals> time_, std::string&& fmt_, const unsigned iter_, const _allocations& allocs_
+    ) noexcept -> std::string
     {
       auto position = fmt_.find("%#");
       while (position != std::string::npos)
@@ -331,13 +710,17 @@ inline namespace chronometro
         position = fmt_.rfind("%#");
       }
 
+      fmt_ = _format_allocations(allocs_, std::move(fmt_), 1);
+
       return _format_time(time_, std::move(fmt_));
     }
 
     template<Unit unit, unsigned n_decimals>
-    auto _total_fmt(const _time<unit, n_decimals> time_, std::string&& fmt_, unsigned n_iters_) noexcept
-      -> std::string
+    auto _total_fmt(
+      const _time<unit, n_decimals> time_, std::string&& fmt_, unsigned n_iters_, const _allocations& allocs_
+    ) noexcept -> std::string
     {
+      fmt_ = _format_allocations(allocs_, std::move(fmt_), 1);
       fmt_ = _format_time(time_, std::move(fmt_));
 
       auto position = fmt_.rfind("%D");
@@ -352,6 +735,8 @@ inline namespace chronometro
         n_iters_ = 1;
       }
 
+      fmt_ = _format_allocations(allocs_, std::move(fmt_), n_iters_);
+
       return _format_time(_time<unit, 3>{time_.nanoseconds/n_iters_}, std::move(fmt_));
     }
     
@@ -369,530 +754,4450 @@ inline namespace chronometro
       return std::chrono::nanoseconds(std::chrono::milliseconds(milliseconds_)).count();
     }
 
-    struct _measure_block;
+    inline auto _read_file(const char* path_, char* buffer_, const std::size_t size_) noexcept -> bool
+    {
+      std::FILE* const file = std::fopen(path_, "r");
 
-    template<std::chrono::nanoseconds::rep DURATION>
-    struct _if_elapsed;
+      if (file == nullptr) return false;
 
-    template<unsigned long long N>
-    struct _loop_n_times;
+      const std::size_t length = std::fread(buffer_, 1, size_ - 1, file);
+      std::fclose(file);
+      buffer_[length] = '\0';
 
-    template<unsigned long long N, unsigned long long offset = 0>
-    struct _if_n_pass;
+      return length != 0;
+    }
 
-    struct _break;
-  }
-//*///------------------------------------------------------------------------------------------------------------------
-# undef  measure_block
-  void   measure_block();
-# define measure_block(...) _chronometro_impl::_measure_block(__VA_ARGS__) = [&]() -> void
-//*///------------------------------------------------------------------------------------------------------------------
-  class Stopwatch
-  {
-    class _guard;
-  public:
-    // return split time
-    inline auto split() noexcept -> _chronometro_impl::_time<Unit::automatic, 0>;
+    inline auto _parse_size(const char* text_) noexcept -> std::size_t
+    {
+      char* suffix = nullptr;
+      auto  size   = static_cast<std::size_t>(std::strtoull(text_, &suffix, 10));
 
-    // return total time
-    inline auto total() noexcept -> _chronometro_impl::_time<Unit::automatic, 0>;
+      switch (*suffix)
+      {
+        case 'K': return size << 10;
+        case 'M': return size << 20;
+        case 'G': return size << 30;
+        default:  return size;
+      }
+    }
 
-    // reset measured times
-    inline void reset() noexcept;
+    inline auto _detect_cache_sizes() noexcept -> CacheSizes
+    {
+      CacheSizes sizes = {32 << 10, 1 << 20, 32 << 20, 64};
 
-    // pause time measurement
-    inline void pause() noexcept;
+#   if defined(__linux__)
+      for (unsigned index = 0; index != 16; ++index)
+      {
+        char path[96], level[16], type[32], size[32];
 
-    // resume time measurement
-    inline void start() noexcept;
+        const int base = std::sprintf(path, "/sys/devices/system/cpu/cpu0/cache/index%u/", index);
 
-    // RAII-style scoped pause/start
-    inline auto avoid() noexcept -> _guard;
+        std::sprintf(path + base, "level");
+        if (not _read_file(path, level, sizeof(level))) break;
 
-    constexpr
-    Stopwatch() noexcept = default;
+        std::sprintf(path + base, "type");
+        if (not _read_file(path, type, sizeof(type)) or type[0] == 'I') continue;
 
-  private:
-    bool                                  _paused         = false;
-    std::chrono::nanoseconds              _duration_total = {};
-    std::chrono::nanoseconds              _duration_split = {};
-    _chronometro_impl::_clock::time_point _previous       = _chronometro_impl::_clock::now();
-    friend Measure;
-  };
-//*///------------------------------------------------------------------------------------------------------------------
-  class Measure
-  {
-    class Iteration;
-  public:
-    // pause measurement
-    inline void pause() noexcept;
+        std::sprintf(path + base, "size");
+        if (not _read_file(path, size, sizeof(size))) continue;
 
-    // resume measurement
-    inline void start() noexcept;
+        switch (level[0])
+        {
+          case '1': sizes.l1d = _parse_size(size); break;
+          case '2': sizes.l2  = _parse_size(size); break;
+          case '3': sizes.l3  = _parse_size(size); break;
+          default:  sizes.l3  = _parse_size(size); break; // treat deeper levels as the last level cache
+        }
 
-    // scoped pause/start of measurement
-    inline auto avoid() noexcept -> Stopwatch::_guard;
+        std::sprintf(path + base, "coherency_line_size");
+        if (_read_file(path, size, sizeof(size)))
+        {
+          sizes.line = _parse_size(size);
+        }
+      }
+#   elif defined(_SC_LEVEL3_CACHE_SIZE)
+      if (::sysconf(_SC_LEVEL1_DCACHE_SIZE) > 0)
+      {
+        sizes.l1d = static_cast<std::size_t>(::sysconf(_SC_LEVEL1_DCACHE_SIZE));
+      }
 
-    // measure one iteration
-    explicit Measure() noexcept = default;
+      if (::sysconf(_SC_LEVEL2_CACHE_SIZE) > 0)
+      {
+        sizes.l2 = static_cast<std::size_t>(::sysconf(_SC_LEVEL2_CACHE_SIZE));
+      }
 
-    // measure iterations
-    inline Measure(unsigned iterations) noexcept;
+      if (::sysconf(_SC_LEVEL3_CACHE_SIZE) > 0)
+      {
+        sizes.l3 = static_cast<std::size_t>(::sysconf(_SC_LEVEL3_CACHE_SIZE));
+      }
 
-    // measure iterations with custom iteration message
-    inline Measure(unsigned iterations, const char* iteration_format) noexcept;
+      if (::sysconf(_SC_LEVEL1_DCACHE_LINESIZE) > 0)
+      {
+        sizes.line = static_cast<std::size_t>(::sysconf(_SC_LEVEL1_DCACHE_LINESIZE));
+      }
+#   endif
 
-    // measure iterations with custom iteration/total message
-    inline Measure(unsigned iterations, const char* iteration_format, const char* total_format) noexcept;
+      if _stz_impl_ABNORMAL(sizes.line == 0 or (sizes.line & (sizes.line - 1)))
+      {
+        sizes.line = 64;
+      }
 
-    // measure one iteration with custom total message
-    inline Measure(const char* total_format) noexcept;
+      return sizes;
+    }
 
-    // measure iterations with custom total message
-    inline Measure(const char* total_format, unsigned iterations) noexcept;
+    // stream over a buffer 1.5 times the size of the last level cache
+    inline void _evict_caches() noexcept
+    {
+      static const std::size_t size = cache_sizes().l3 + cache_sizes().l3/2;
+      static const std::unique_ptr<char[]> buffer = []() -> std::unique_ptr<char[]>
+      {
+        std::unique_ptr<char[]> data(new char[size]);
 
-  private:
-    const unsigned    _iterations = 1;
-    unsigned          _remaining  = _iterations;
-    const char* const _split_fmt  = nullptr;
-    const char* const _total_fmt  = "total elapsed time: %ms";
-    Stopwatch         _stopwatch;
-    class _iterator;
-  public:
-    inline auto begin()     noexcept -> _iterator;
-    inline auto end() const noexcept -> _iterator;
-    inline ~Measure() noexcept;
-  private:
-    inline auto _view() noexcept -> Iteration;
-    inline bool _good() noexcept;
-    inline void _next() noexcept;
-    inline void _stop() noexcept;
-    friend _chronometro_impl::_measure_block;
-  };
-//*///------------------------------------------------------------------------------------------------------------------
-  class Measure::Iteration final
-  {
-  public:
-    // current measurement iteration
-    const unsigned value;
+        // fault every page in so that reads do not all hit the shared zero page
+        for (std::size_t k = 0; k < size; ++k) data[k] = static_cast<char>(k);
 
-    // pause measurements
-    inline void pause() noexcept;
+        return data;
+      }();
 
-    // resume measurement
-    inline void start() noexcept;
+      const std::size_t line = cache_sizes().line;
+      char sink = 0;
 
-    // scoped pause/start of measurement
-    inline auto avoid() noexcept -> Stopwatch::_guard;
+      for (std::size_t k = 0; k < size; k += line)
+      {
+        sink ^= buffer[k];
+      }
 
-  private:
-    friend Measure;
-    inline explicit Iteration(unsigned current_iteration, Measure* measurement) noexcept;
-    Measure* const _measurement;
-  };
-//*///------------------------------------------------------------------------------------------------------------------
-  namespace _chronometro_impl
-  {
-    struct _measure_block final
+      *static_cast<volatile char*>(&sink) = sink;
+    }
+
+    inline void _flush_cache_lines(const void* const data_, const std::size_t size_) noexcept
     {
-      template<typename... T>
-      _measure_block(T... args)
-        : _measure(args...)
-      {}
+      const std::size_t line  = cache_sizes().line;
+      const char*       first = static_cast<const char*>(data_);
+      const char* const last  = first + size_;
 
-      template<typename L>
-      void operator=(L&& body_) &&
+      first -= reinterpret_cast<std::uintptr_t>(first) & (line - 1);
+
+#   if defined(__SSE2__)
+      for (; first < last; first += line)
       {
-        try
+        __builtin_ia32_clflush(first);
+      }
+      __builtin_ia32_mfence();
+#   elif defined(__aarch64__)
+      for (; first < last; first += line)
+      {
+        __asm__ __volatile__("dc civac, %0" : : "r"(first) : "memory");
+      }
+      __asm__ __volatile__("dsb ish" : : : "memory");
+#   else
+      (void)first, (void)last;
+      _evict_caches();
+#   endif
+    }
+
+    // nanoseconds per load when chasing pointers through every line of 'data_' in random order, best of 'rounds_'
+    inline auto _chase_latency(char* const data_, const std::size_t size_, const unsigned rounds_) -> double
+    {
+      const std::size_t line    = cache_sizes().line;
+      const std::size_t n_lines = size_/line;
+
+      if (n_lines < 2) return 0;
+
+      std::vector<std::size_t> order(n_lines);
+      for (std::size_t k = 0; k < n_lines; ++k)
+      {
+        order[k] = k;
+      }
+
+      // a single cycle starting at the first line, which defeats the prefetchers
+      std::minstd_rand generator(static_cast<std::minstd_rand::result_type>(_clock::now().time_since_epoch().count()));
+      std::shuffle(order.begin() + 1, order.end(), generator);
+
+      for (std::size_t k = 0; k < n_lines; ++k)
+      {
+        *reinterpret_cast<std::size_t*>(data_ + order[k]*line) = order[(k + 1)%n_lines]*line;
+      }
+
+      double               best   = std::numeric_limits<double>::max();
+      std::size_t          offset = 0;
+      volatile std::size_t sink;
+
+      for (unsigned round = 0; round < rounds_; ++round)
+      {
+        const auto start = _clock::now();
+        for (std::size_t k = 0; k < n_lines; ++k)
         {
-          for (; _measure._good(); _measure._next())
-          {
-            body_();
-          }
+          offset = *reinterpret_cast<const std::size_t*>(data_ + offset);
         }
-        catch(_break&)
-        {
-          _measure._stop();
-        } 
+        // observed before the clock is read, through an object that is itself volatile, or the chase is elided
+        sink = offset;
+        const auto stop  = _clock::now();
+
+        best = std::min(best, static_cast<double>(_to_ns(stop - start))/static_cast<double>(n_lines));
       }
 
-    private:
-      Measure _measure;
-    };
+      (void)sink;
 
-    template<std::chrono::nanoseconds::rep DURATION>
-    struct _if_elapsed final
+      return best;
+    }
+
+    // bytes per nanosecond when summing 'data_' sequentially, best of 'rounds_'
+    inline auto _read_bandwidth(const char* const data_, const std::size_t size_, const unsigned rounds_) noexcept
+      -> double
     {
-      static_assert(DURATION > 0, "stz: if_elapsed: 'DURATION' must be non-zero and positive.");
+      const auto* const words   = reinterpret_cast<const std::uint64_t*>(data_);
+      const std::size_t n_words = size_/sizeof(std::uint64_t);
 
-      template<typename L>
-      void operator=(L&& body_) &&
-      {
-        static _chronometro_impl::_clock::time_point goal = {};
-        constexpr auto diff = std::chrono::nanoseconds(DURATION);
+      double                 best = 0;
+      std::uint64_t          sum  = 0;
+      volatile std::uint64_t sink;
 
-        if (_chronometro_impl::_clock::now() > goal)
+      for (unsigned round = 0; round < rounds_; ++round)
+      {
+        const auto start = _clock::now();
+        for (std::size_t k = 0; k < n_words; ++k)
         {
-          goal = _chronometro_impl::_clock::now() + diff;
-
-          body_();
+          sum += words[k];
         }
+        sink = sum;
+        const auto stop  = _clock::now();
+
+        const auto nanoseconds = _to_ns(stop - start);
+        best = std::max(best, static_cast<double>(n_words*sizeof(std::uint64_t))
+          /static_cast<double>(nanoseconds > 0 ? nanoseconds : 1));
       }
-    };
 
-    template<unsigned long long N>
-    struct _loop_n_times final
+      (void)sink;
+
+      return best;
+    }
+
+#if defined(__linux__)
+    // busy and total jiffies of 'cpu_' from /proc/stat
+    inline auto _cpu_jiffies(const int cpu_, unsigned long long& busy_, unsigned long long& total_) noexcept -> bool
     {
-      static_assert(N > 0, "stz: if_elapsed: 'N' must be non-zero and positive.");
+      std::FILE* const file = std::fopen("/proc/stat", "r");
 
-      template<typename L>
-      void operator=(L&& body_) &&
+      if (file == nullptr) return false;
+
+      char line[256], label[16];
+      std::sprintf(label, "cpu%d ", cpu_);
+      const std::size_t length = std::strlen(label);
+
+      bool found = false;
+      while (not found and std::fgets(line, sizeof(line), file))
       {
-        try
+        if (std::strncmp(line, label, length) != 0) continue;
+
+        unsigned long long fields[8] = {};
+        char* cursor = line + length;
+        for (auto& field : fields)
         {
-          for (unsigned long long n = N; n; --n)
-          {
-            body_();
-          }
+          field = std::strtoull(cursor, &cursor, 10);
         }
-        catch(_break&) {}
-        
+
+        total_ = 0;
+        for (const auto field : fields) total_ += field;
+        busy_  = total_ - fields[3] - fields[4]; // minus idle and iowait
+
+        found = true;
       }
-    };
 
-    template<unsigned long long N, unsigned long long offset>
-    struct _if_n_pass final
+      std::fclose(file);
+
+      return found;
+    }
+
+    // cpus listed in a sysfs cpu list such as "0-3,8"
+    inline auto _parse_cpu_list(const char* text_, cpu_set_t& cpus_) noexcept -> unsigned
     {
-      template<typename L>
-      void operator=(L&& body_) &&
+      CPU_ZERO(&cpus_);
+
+      unsigned count = 0;
+      char*    cursor = const_cast<char*>(text_);
+      while (*cursor >= '0' and *cursor <= '9')
       {
-        static unsigned long long pass = N - offset - 1;
-        if (++pass >= N)
+        const auto first = std::strtoul(cursor, &cursor, 10);
+        auto       last  = first;
+
+        if (*cursor == '-')
         {
-          pass = 0;
+          last = std::strtoul(cursor + 1, &cursor, 10);
+        }
 
-          body_();
+        for (auto cpu = first; cpu <= last and cpu < CPU_SETSIZE; ++cpu, ++count)
+        {
+          CPU_SET(cpu, &cpus_);
         }
+
+        if (*cursor == ',') ++cursor;
       }
-    };
 
-    struct _break final : public std::exception
+      return count;
+    }
+
+    // online NUMA nodes, listed in the same format as cpus
+    inline auto _online_nodes(cpu_set_t& nodes_) noexcept -> unsigned
     {
-    public:
-      _break(const char* caller_) noexcept
-        : _message(std::string("stz: break_now: broke from '").append(caller_).append("'."))
-      {}
+      char text[256];
 
-      const char* what() const noexcept override
+      if (not _read_file("/sys/devices/system/node/online", text, sizeof(text)))
       {
-        return _message.c_str();
+        CPU_ZERO(&nodes_);
+        return 0;
       }
 
-    private:
-      const std::string _message;
+      return _parse_cpu_list(text, nodes_);
+    }
+
+    // cpus of NUMA 'node_', none if it does not exist or only has memory
+    inline auto _node_cpus(const unsigned node_, cpu_set_t& cpus_) noexcept -> unsigned
+    {
+      char path[64], text[1024];
+      std::sprintf(path, "/sys/devices/system/node/node%u/cpulist", node_);
+
+      if (not _read_file(path, text, sizeof(text)))
+      {
+        CPU_ZERO(&cpus_);
+        return 0;
+      }
+
+      return _parse_cpu_list(text, cpus_);
+    }
+
+    // memory policies of <linux/mempolicy.h>, set through raw system calls so as not to depend on libnuma
+    constexpr int           _mpol_bind      = 2;
+    constexpr unsigned      _mpol_mf_strict = 1;
+    constexpr unsigned      _mpol_mf_move   = 2;
+    constexpr unsigned long _max_nodes      = 1024;
+
+    struct _node_mask
+    {
+      unsigned long bits[_max_nodes/(8*sizeof(unsigned long))];
     };
-  }
-//*///------------------------------------------------------------------------------------------------------------------
-  class Stopwatch::_guard final
-  {
-  public:
-    ~_guard() noexcept
+
+    inline auto _node_mask_of(const unsigned node_) noexcept -> _node_mask
     {
-      _stopwatch->start();
+      _node_mask mask = {};
+      mask.bits[node_/(8*sizeof(unsigned long))] = 1ul << (node_%(8*sizeof(unsigned long)));
+
+      return mask;
     }
-    
-  private:
-    explicit _guard(Stopwatch* const stopwatch_) noexcept
-      : _stopwatch(stopwatch_)
+
+    // bind the pages of 'data_' to NUMA 'node_', moving those already faulted in
+    inline auto _mbind(void* const data_, const std::size_t size_, const unsigned node_) noexcept -> bool
     {
-      _stopwatch->pause();
+      if (node_ >= _max_nodes) return false;
+
+      const auto mask = _node_mask_of(node_);
+
+      // the kernel reads one bit less than 'maxnode'
+      return ::syscall(SYS_mbind, data_, size_, _mpol_bind, mask.bits, _max_nodes + 1,
+        _mpol_mf_strict | _mpol_mf_move) == 0;
     }
 
-    Stopwatch* const _stopwatch;
-    
-    friend Stopwatch;
-  };
-//*///------------------------------------------------------------------------------------------------------------------
-  class Measure::_iterator final
-  {
-  public:
-    constexpr _iterator() noexcept = default;
+    struct _mempolicy
+    {
+      int        mode;
+      _node_mask mask;
+    };
 
-    _iterator(Measure* const measure_) noexcept
-      : _measure(measure_)
-    {}
+    // memory policy of the calling thread, mode flags included
+    inline auto _get_mempolicy(_mempolicy& policy_) noexcept -> bool
+    {
+      return ::syscall(SYS_get_mempolicy, &policy_.mode, policy_.mask.bits, _max_nodes + 1, nullptr, 0ul) == 0;
+    }
 
-    void operator++() const noexcept
+    // bind allocations of the calling thread to NUMA 'node_'
+    inline auto _set_mempolicy(const unsigned node_) noexcept -> bool
     {
-      _measure->_next();
+      if (node_ >= _max_nodes) return false;
+
+      const auto mask = _node_mask_of(node_);
+
+      return ::syscall(SYS_set_mempolicy, _mpol_bind, mask.bits, _max_nodes + 1) == 0;
     }
 
-    bool operator!=(const _iterator&) const noexcept
+    // restore a memory policy obtained from _get_mempolicy
+    inline auto _set_mempolicy(const _mempolicy& policy_) noexcept -> bool
     {
-      return _measure->_good();
+      return ::syscall(SYS_set_mempolicy, policy_.mode, policy_.mask.bits, _max_nodes + 1) == 0;
     }
+#endif
 
-    Iteration operator*() const noexcept
+    using _clock_source = std::int64_t (*)();
+
+    inline auto _steady_source() noexcept -> std::int64_t
     {
-      return _measure->_view();
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
     }
-  private:
-    Measure* const _measure = nullptr;
-  };
-//*///------------------------------------------------------------------------------------------------------------------
-  template<Unit unit>
-  void sleep(const unsigned long long amount_) noexcept
-  {
-    const auto span = std::chrono::nanoseconds{_chronometro_impl::_unit_helper<unit>::factor * amount_};
-    const auto goal = span + _chronometro_impl::_clock::now();
-    while (_chronometro_impl::_clock::now() < goal);
-  }
 
-  template<typename R, typename P>
-  void sleep(const std::chrono::duration<R, P> duration_) noexcept
-  {
-    const auto goal = _chronometro_impl::_clock::now() + duration_;
-    while (_chronometro_impl::_clock::now() < goal);
-  }
+    inline auto _high_resolution_source() noexcept -> std::int64_t
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+    }
 
-  template<>
-  void sleep<Unit::automatic>(unsigned long long) noexcept = delete;
-//*///------------------------------------------------------------------------------------------------------------------
-# undef  if_elapsed
-  void   if_elapsed();
-# define if_elapsed(DURATION) _chronometro_impl::_if_elapsed<stz::_chronometro_impl::_to_ns(DURATION)>() = [&]() -> void
-//*///------------------------------------------------------------------------------------------------------------------
-# undef  loop_n_times
-  void   loop_n_times();
-# define loop_n_times(N) _chronometro_impl::_loop_n_times<N>() = [&]() -> void
-//*///------------------------------------------------------------------------------------------------------------------
-# undef  if_n_pass
-  void   if_n_pass();
-# define if_n_pass(...) _chronometro_impl::_if_n_pass<__VA_ARGS__>() = [&]() -> void
-//*///------------------------------------------------------------------------------------------------------------------
-# undef  break_now
-  inline
-  void   break_now(const char* const caller_) { throw _chronometro_impl::_break(caller_); }
-# define break_now break_now(__func__)
-//*///------------------------------------------------------------------------------------------------------------------
-# undef  break_after_n
-  void   break_after_n();
-# define break_after_n(...) if_n_pass(__VA_ARGS__) { stz::break_now; }
-//*///------------------------------------------------------------------------------------------------------------------
-  _stz_impl_NODISCARD_REASON("split: not using the return value makes no sens.")
-  auto Stopwatch::split() noexcept -> _chronometro_impl::_time<Unit::automatic, 0>
-  {
-    const auto now = _chronometro_impl::_clock::now();
+#if defined(__linux__)
+    inline auto _monotonic_raw_source() noexcept -> std::int64_t
+    {
+      timespec time;
+      ::clock_gettime(CLOCK_MONOTONIC_RAW, &time);
+      return std::int64_t(time.tv_sec)*1000000000 + time.tv_nsec;
+    }
 
-    auto split_duration = _duration_split;
-    _duration_split     = {};
+    inline auto _monotonic_coarse_source() noexcept -> std::int64_t
+    {
+      timespec time;
+      ::clock_gettime(CLOCK_MONOTONIC_COARSE, &time);
+      return std::int64_t(time.tv_sec)*1000000000 + time.tv_nsec;
+    }
+#endif
 
-    if _stz_impl_EXPECTED(not _paused)
+#if defined(_stz_impl_TSC)
+    struct _tsc_calibration
     {
-      _duration_total += now - _previous;
-      split_duration  += now - _previous;
+      std::uint64_t base;
+      double        ns_per_tick; // zero until calibrated
+    };
+
+    inline auto _tsc() noexcept -> _tsc_calibration&
+    {
+      static _tsc_calibration calibration = {0, 0};
+      return calibration;
+    }
+
+    inline auto _tsc_source() noexcept -> std::int64_t
+    {
+      const auto& calibration = _tsc();
+      return static_cast<std::int64_t>(static_cast<double>(__rdtsc() - calibration.base)*calibration.ns_per_tick);
+    }
+
+    // the counter must tick at a constant rate through frequency and sleep state changes
+    inline auto _tsc_invariant() noexcept -> bool
+    {
+      unsigned eax, ebx, ecx, edx;
+      return __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) and (edx & (1u << 8));
+    }
+
+    // calibrated once only, so that a RuntimeClock dispatched to it never jumps
+    inline void _calibrate_tsc() noexcept
+    {
+      auto& calibration = _tsc();
+      if (calibration.ns_per_tick != 0) return;
+
+      const auto start = std::chrono::steady_clock::now();
+      const auto first = __rdtsc();
+      while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(20));
+      const auto stop  = std::chrono::steady_clock::now();
+      const auto last  = __rdtsc();
+
+      calibration.base        = first;
+      calibration.ns_per_tick = static_cast<double>(std::chrono::nanoseconds(stop - start).count())
+        /static_cast<double>(last - first);
+    }
+#endif
+
+#if defined(_stz_impl_THREADSAFE)
+    // guards clock characterization and selection
+    inline auto _clock_mtx() noexcept -> std::mutex&
+    {
+      static std::mutex mtx;
+      return mtx;
+    }
+#endif
+
+    inline auto _characterize_clock(
+      const Clock clock_, const char* const name_, const _clock_source source_, const bool steady_
+    ) noexcept -> ClockCharacteristics
+    {
+      ClockCharacteristics characteristics = {clock_, name_, true, {}, 0, steady_, true};
+
+      const unsigned n_reads = 1 << 16;
+
+      auto previous = source_();
+      const auto start = std::chrono::steady_clock::now();
+      for (unsigned k = 0; k < n_reads; ++k)
+      {
+        const auto now = source_();
+        characteristics.monotonic &= now >= previous;
+        previous = now;
+      }
+      const auto stop = std::chrono::steady_clock::now();
+
+      characteristics.read_cost = static_cast<double>(std::chrono::nanoseconds(stop - start).count())/n_reads;
+
+      // smallest of the first steps observed, giving up on coarse clocks after 50 ms
+      auto resolution = std::numeric_limits<std::int64_t>::max();
+      const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(50);
+      previous = source_();
+      for (unsigned k = 1, n_steps = 0; n_steps < 64; ++k)
+      {
+        const auto now = source_();
+        if (now != previous)
+        {
+          characteristics.monotonic &= now > previous;
+          resolution = std::min(resolution, now - previous);
+          previous   = now;
+          ++n_steps;
+        }
+
+        if ((k % 256 == 0) and std::chrono::steady_clock::now() > deadline) break;
+      }
+      characteristics.resolution = std::chrono::nanoseconds(resolution);
+
+#if defined(__linux__)
+      // hop across every allowed cpu and back, the readings must never go backwards
+      cpu_set_t affinity;
+      if (::sched_getaffinity(0, sizeof(affinity), &affinity) == 0 and CPU_COUNT(&affinity) > 1)
+      {
+        previous = source_();
+        for (int k = 0; k < 2*CPU_SETSIZE; ++k)
+        {
+          const int cpu = (k < CPU_SETSIZE) ? k : 2*CPU_SETSIZE - 1 - k;
+          if (not CPU_ISSET(cpu, &affinity)) continue;
+
+          cpu_set_t pinned;
+          CPU_ZERO(&pinned);
+          CPU_SET(cpu, &pinned);
+          if (::sched_setaffinity(0, sizeof(pinned), &pinned) != 0) continue;
+
+          const auto now = source_();
+          characteristics.consistent &= now >= previous;
+          previous = now;
+        }
+
+        ::sched_setaffinity(0, sizeof(affinity), &affinity);
+      }
+#endif
+
+      return characteristics;
+    }
+
+    inline auto _characterize_clocks() -> std::vector<ClockCharacteristics>
+    {
+      std::vector<ClockCharacteristics> characteristics;
+
+      characteristics.push_back(_characterize_clock(
+        Clock::steady, "steady_clock", &_steady_source, std::chrono::steady_clock::is_steady));
+
+      characteristics.push_back(_characterize_clock(
+        Clock::high_resolution, "high_resolution_clock", &_high_resolution_source,
+        std::chrono::high_resolution_clock::is_steady));
+
+#if defined(__linux__)
+      timespec resolution;
+      if (::clock_getres(CLOCK_MONOTONIC_RAW, &resolution) == 0)
+      {
+        characteristics.push_back(_characterize_clock(
+          Clock::monotonic_raw, "CLOCK_MONOTONIC_RAW", &_monotonic_raw_source, true));
+      }
+      else
+      {
+        characteristics.push_back({Clock::monotonic_raw, "CLOCK_MONOTONIC_RAW", false, {}, 0, false, false});
+      }
+
+      if (::clock_getres(CLOCK_MONOTONIC_COARSE, &resolution) == 0)
+      {
+        characteristics.push_back(_characterize_clock(
+          Clock::monotonic_coarse, "CLOCK_MONOTONIC_COARSE", &_monotonic_coarse_source, true));
+      }
+      else
+      {
+        characteristics.push_back({Clock::monotonic_coarse, "CLOCK_MONOTONIC_COARSE", false, {}, 0, false, false});
+      }
+#else
+      characteristics.push_back({Clock::monotonic_raw,    "CLOCK_MONOTONIC_RAW",    false, {}, 0, false, false});
+      characteristics.push_back({Clock::monotonic_coarse, "CLOCK_MONOTONIC_COARSE", false, {}, 0, false, false});
+#endif
+
+#if defined(_stz_impl_TSC)
+      if (_tsc_invariant())
+      {
+        _calibrate_tsc();
+        characteristics.push_back(_characterize_clock(Clock::tsc, "TSC", &_tsc_source, true));
+      }
+      else
+#endif
+      {
+        characteristics.push_back({Clock::tsc, "TSC", false, {}, 0, false, false});
+      }
+
+      return characteristics;
+    }
+
+    inline auto _clock_source_of(const Clock clock_) noexcept -> _clock_source
+    {
+      switch (clock_)
+      {
+        case Clock::high_resolution: return &_high_resolution_source;
+#if defined(__linux__)
+        case Clock::monotonic_raw:    return &_monotonic_raw_source;
+        case Clock::monotonic_coarse: return &_monotonic_coarse_source;
+#endif
+#if defined(_stz_impl_TSC)
+        case Clock::tsc: return &_tsc_source;
+#endif
+        default: return &_steady_source;
+      }
+    }
+
+    inline auto _select_clock(std::chrono::nanoseconds precision, bool explicitly) -> ClockCharacteristics;
+
+    inline auto _select_on_first_read() -> std::int64_t;
+
+    // source RuntimeClock reads, constant-initialized so that reading it needs no guard
+    inline auto _runtime_source() noexcept -> std::atomic<_clock_source>&
+    {
+      static std::atomic<_clock_source> source(&_select_on_first_read);
+      return source;
+    }
+
+    inline auto _runtime_selection() noexcept -> ClockCharacteristics&
+    {
+      static ClockCharacteristics selection = {Clock::steady, "steady_clock", true, {}, 0, true, true};
+      return selection;
+    }
+
+    auto _select_clock(const std::chrono::nanoseconds precision_, const bool explicitly_) -> ClockCharacteristics
+    {
+#   if defined(_stz_impl_THREADSAFE)
+      std::lock_guard<std::mutex> lock(_clock_mtx());
+#   endif
+
+      if (_runtime_source().load(std::memory_order_acquire) != &_select_on_first_read)
+      {
+        if (explicitly_)
+        {
+          _stz_impl_DECLARE_LOCK(_out_mtx);
+          io::wrn() << "stz: select_clock: RuntimeClock was already read, keeping "
+            << _runtime_selection().name << std::endl;
+        }
+
+        return _runtime_selection();
+      }
+
+      const auto characteristics = _characterize_clocks();
+
+      const ClockCharacteristics* best = nullptr;
+      for (const auto& candidate : characteristics)
+      {
+        if (candidate.available and candidate.monotonic and candidate.consistent
+          and candidate.resolution <= precision_ and (best == nullptr or candidate.read_cost < best->read_cost))
+        {
+          best = &candidate;
+        }
+      }
+
+      if _stz_impl_ABNORMAL(best == nullptr)
+      {
+        best = &characteristics.front();
+
+        _stz_impl_DECLARE_LOCK(_out_mtx);
+        io::wrn() << "stz: select_clock: no clock resolves " << precision_.count()
+          << " ns, falling back to " << best->name << std::endl;
+      }
+
+      _runtime_selection() = *best;
+      _runtime_source().store(_clock_source_of(best->clock), std::memory_order_release);
+
+      // not reported, reading a clock should not print; select_clock() returns the selection to report
+      return *best;
+    }
+
+    auto _select_on_first_read() -> std::int64_t
+    {
+      _select_clock(std::chrono::nanoseconds(100), false);
+      return _runtime_source().load(std::memory_order_acquire)();
+    }
+
+    // log-linear histogram of durations: exact below 16 ns, then 8 buckets per power of two
+    struct _histogram final
+    {
+      static constexpr unsigned n_buckets = 16 + 8*44;
+
+      std::uint64_t count;
+      std::int64_t  sum;
+      std::int64_t  max;
+      std::uint32_t buckets[n_buckets];
+
+      static auto bucket(const std::int64_t nanoseconds_) noexcept -> unsigned
+      {
+        if (nanoseconds_ < 16) return nanoseconds_ > 0 ? static_cast<unsigned>(nanoseconds_) : 0;
+
+        const auto value = static_cast<std::uint64_t>(nanoseconds_);
+#     if defined(__GNUC__) or defined(__clang__)
+        const unsigned msb = 63 - static_cast<unsigned>(__builtin_clzll(value));
+#     else
+        unsigned msb = 4;
+        while (value >> (msb + 1)) ++msb;
+#     endif
+        const unsigned index = 16 + (msb - 4)*8 + static_cast<unsigned>((value >> (msb - 3)) & 7);
+
+        return (index < n_buckets) ? index : n_buckets - 1;
+      }
+
+      static auto lower(const unsigned bucket_) noexcept -> std::int64_t
+      {
+        if (bucket_ < 16) return bucket_;
+
+        const unsigned msb = (bucket_ - 16)/8 + 4;
+        return static_cast<std::int64_t>((8 + (bucket_ - 16)%8)) << (msb - 3);
+      }
+
+      void clear() noexcept
+      {
+        count = 0;
+        sum   = 0;
+        max   = 0;
+        for (auto& bucket_count : buckets) bucket_count = 0;
+      }
+
+      void record(const std::int64_t nanoseconds_) noexcept
+      {
+        ++count;
+        sum += nanoseconds_;
+        max  = std::max(max, nanoseconds_);
+        ++buckets[bucket(nanoseconds_)];
+      }
+
+      void merge(const _histogram& other_) noexcept
+      {
+        count += other_.count;
+        sum   += other_.sum;
+        max    = std::max(max, other_.max);
+        for (unsigned k = 0; k < n_buckets; ++k) buckets[k] += other_.buckets[k];
+      }
+
+      // upper bound of the bucket holding the 'quantile_', clipped to the maximum
+      auto percentile(const double quantile_) const noexcept -> std::int64_t
+      {
+        if (count == 0) return 0;
+
+        const auto target = static_cast<std::uint64_t>(std::ceil(quantile_*static_cast<double>(count)));
+
+        std::uint64_t cumulated = 0;
+        for (unsigned k = 0; k < n_buckets; ++k)
+        {
+          cumulated += buckets[k];
+
+          if (cumulated >= target and cumulated)
+          {
+            return (k + 1 < n_buckets) ? std::min(lower(k + 1) - 1, max) : max;
+          }
+        }
+
+        return max;
+      }
+    };
+
+    // layout of a SharedMetrics segment, _shared_version must change whenever it does
+    constexpr std::uint32_t _shared_version = 2;
+
+    // the segment is shared between processes, where only lock-free atomics stay atomic
+    static_assert(ATOMIC_LLONG_LOCK_FREE == 2 and ATOMIC_INT_LOCK_FREE == 2,
+      "stz: SharedMetrics: 64 and 32 bit atomics must be lock-free.");
+
+    // reads of a metric that keeps changing, or whose writer died mid-update, give up after that many attempts
+    constexpr unsigned _shared_patience = 1u << 16;
+
+    struct alignas(64) _shared_header final
+    {
+      char                       magic[8]; // "stzchz"
+      std::uint32_t              version;
+      std::uint32_t              capacity;
+      std::uint32_t              metric_size;
+      std::atomic<std::uint32_t> n_metrics;
+      std::int64_t               created; // seconds since the epoch
+      std::int64_t               pid;
+    };
+
+    // fields other than 'counter' are only consistent when read between two equal even 'sequence' values
+    struct alignas(64) _shared_metric final
+    {
+      std::atomic<std::uint64_t> sequence; // 0 until registered, odd with the writer's pid above bit 32 while written
+      char                       name[48];
+      std::atomic<std::uint64_t> counter;
+      std::atomic<std::uint64_t> count;
+      std::atomic<std::int64_t>  sum;
+      std::atomic<std::int64_t>  min;
+      std::atomic<std::int64_t>  max;
+      std::atomic<std::uint32_t> buckets[_histogram::n_buckets];
+    };
+
+#if defined(__unix__)
+    inline auto _shared_pid_tag() noexcept -> std::uint64_t&
+    {
+      static std::uint64_t tag = 0;
+      return tag;
+    }
+
+    inline void _refresh_shared_pid() noexcept
+    {
+      _shared_pid_tag() = static_cast<std::uint64_t>(::getpid()) << 32;
+    }
+#endif
+
+    // pid of the calling process shifted above bit 32, cached as getpid() is a system call on every record
+    inline auto _shared_pid() noexcept -> std::uint64_t
+    {
+#   if defined(__unix__)
+      // refreshed in forked children, which would otherwise tag their writes with their parent's pid
+      static const bool cached = (_refresh_shared_pid(),
+        ::pthread_atfork(nullptr, nullptr, &_refresh_shared_pid) == 0);
+      (void)cached;
+
+      return _shared_pid_tag();
+#   else
+      return 0;
+#   endif
+    }
+
+    // whether the writer holding the odd 'sequence_' died without releasing it
+    inline auto _shared_owner_dead(const std::uint64_t sequence_) noexcept -> bool
+    {
+#   if defined(__unix__)
+      const auto pid = static_cast<pid_t>(sequence_ >> 32);
+      return pid > 0 and ::kill(pid, 0) != 0 and errno == ESRCH;
+#   else
+      (void)sequence_;
+      return false;
+#   endif
+    }
+
+    // even sequence following 'sequence_', skipping 0 which marks unregistered metrics
+    inline auto _shared_next(const std::uint64_t sequence_) noexcept -> std::uint64_t
+    {
+      const std::uint64_t next = ((sequence_ | 1) + 1) & 0xffffffff;
+      return next ? next : 2;
+    }
+
+    struct _measure_block;
+
+    struct _isolate_block;
+
+    template<std::chrono::nanoseconds::rep DURATION>
+    struct _if_elapsed;
+
+    template<unsigned long long N>
+    struct _loop_n_times;
+
+    struct _loop_at_rate;
+
+    template<unsigned long long N, unsigned long long offset = 0>
+    struct _if_n_pass;
+
+    struct _break;
+  }
+//*///------------------------------------------------------------------------------------------------------------------
+# undef  measure_block
+  void   measure_block();
+#if CHRONOMETRO_LEVEL > 0
+# define measure_block(...) _chronometro_impl::_measure_block(__VA_ARGS__) = [&]() -> void
+#else
+# define measure_block(...) _chronometro_impl::_null_measure_block(__VA_ARGS__) = [&]() -> void
+#endif
+//*///------------------------------------------------------------------------------------------------------------------
+# undef  isolate_block
+  void   isolate_block();
+# define isolate_block(...) _chronometro_impl::_isolate_block(__VA_ARGS__) = [&]() -> void
+//*///------------------------------------------------------------------------------------------------------------------
+  // render 'time' as "<value> <unit>" into 'buffer' without allocating, returns the length written
+  template<Unit unit, unsigned n_decimals>
+  auto format_duration(_chronometro_impl::_time<unit, n_decimals> time, char* buffer, std::size_t size) noexcept
+    -> std::size_t;
+
+  // render 'duration' as "<value> <unit>" into 'buffer' without allocating, returns the length written
+  template<Unit unit = Unit::automatic, unsigned n_decimals = 0>
+  auto format_duration(std::chrono::nanoseconds duration, char* buffer, std::size_t size) noexcept -> std::size_t;
+//*///------------------------------------------------------------------------------------------------------------------
+  class Stopwatch
+  {
+    class _guard;
+  public:
+    // return split time
+    inline auto split() noexcept -> _chronometro_impl::_time<Unit::automatic, 0>;
+
+    // return total time
+    inline auto total() noexcept -> _chronometro_impl::_time<Unit::automatic, 0>;
+
+    // reset measured times
+    inline void reset() noexcept;
+
+    // pause time measurement
+    inline void pause() noexcept;
+
+    // resume time measurement
+    inline void start() noexcept;
+
+    // RAII-style scoped pause/start
+    inline auto avoid() noexcept -> _guard;
+
+    constexpr
+    Stopwatch() noexcept = default;
+
+  private:
+    bool                                  _paused         = false;
+    std::chrono::nanoseconds              _duration_total = {};
+    std::chrono::nanoseconds              _duration_split = {};
+    _chronometro_impl::_clock::time_point _previous       = _chronometro_impl::_clock::now();
+    friend Measure;
+  };
+//*///------------------------------------------------------------------------------------------------------------------
+  class Measure
+  {
+    class Iteration;
+  public:
+    // pause measurement
+    inline void pause() noexcept;
+
+    // resume measurement
+    inline void start() noexcept;
+
+    // scoped pause/start of measurement
+    inline auto avoid() noexcept -> Stopwatch::_guard;
+
+    // cache state to enforce before each iteration
+    inline auto cache(Cache mode) & noexcept -> Measure&;
+
+    // flush buffer out of the caches before each iteration
+    inline auto flush(const void* data, std::size_t size) & noexcept -> Measure&;
+
+    // pin the measuring thread to 'cpu' for the duration of the run
+    inline auto pin(unsigned cpu) & noexcept -> Measure&;
+
+    // pin the measuring thread to the cpus of NUMA 'cpu_node' and bind its allocations to 'memory_node' for
+    // the duration of the run, buffers allocated beforehand can be placed with NumaBuffer
+    inline auto numa(unsigned cpu_node, unsigned memory_node) & noexcept -> Measure&;
+
+    // warn about and record a noisy environment before the run
+    inline auto audit() & noexcept -> Measure&;
+
+    // environment recorded by the last audited run
+    inline auto environment() const noexcept -> const Environment&;
+
+    // call 'setup' with the iteration's index before it, outside the timed interval
+    inline auto setup(std::function<void(unsigned iteration)> setup) & noexcept -> Measure&;
+
+    // call 'teardown' with the iteration's index after it, outside the timed interval
+    inline auto teardown(std::function<void(unsigned iteration)> teardown) & noexcept -> Measure&;
+
+    // call 'prepare' ahead of every 'batch' iterations with their first index and count, outside the timed interval
+    inline auto prepare(unsigned batch, std::function<void(unsigned first, unsigned count)> prepare) & noexcept
+      -> Measure&;
+
+    // measure one iteration
+    explicit Measure() noexcept = default;
+
+    // measure iterations
+    inline Measure(unsigned iterations) noexcept;
+
+    // measure iterations with custom iteration message
+    inline Measure(unsigned iterations, const char* iteration_format) noexcept;
+
+    // measure iterations with custom iteration/total message
+    inline Measure(unsigned iterations, const char* iteration_format, const char* total_format) noexcept;
+
+    // measure one iteration with custom total message
+    inline Measure(const char* total_format) noexcept;
+
+    // measure iterations with custom total message
+    inline Measure(const char* total_format, unsigned iterations) noexcept;
+
+  private:
+    const unsigned    _iterations = 1;
+    unsigned          _remaining  = _iterations;
+    const char* const _split_fmt  = nullptr;
+    const char* const _total_fmt  = "total elapsed time: %ms";
+    Stopwatch         _stopwatch;
+    Cache             _cache      = Cache::warm;
+    int               _cpu        = -1;
+    int               _cpu_node    = -1;
+    int               _memory_node = -1;
+    bool              _audit      = false;
+    Environment       _environment = {};
+    _chronometro_impl::_allocations _allocations_start = {};
+    _chronometro_impl::_allocations _allocations_split = {};
+    _chronometro_impl::_allocations _allocations_total = {};
+    std::vector<std::pair<const void*, std::size_t>> _flushed;
+    std::function<void(unsigned)>           _setup;
+    std::function<void(unsigned)>           _teardown;
+    std::function<void(unsigned, unsigned)> _batch;
+    unsigned                                _batch_size = 0;
+    bool                                    _timing     = false;
+#if defined(__linux__)
+    cpu_set_t         _affinity;
+    _chronometro_impl::_mempolicy _memory_policy;
+#endif
+    class _iterator;
+  public:
+    inline auto begin()     noexcept -> _iterator;
+    inline auto end() const noexcept -> _iterator;
+    inline ~Measure() noexcept;
+  private:
+    inline auto _view() noexcept -> Iteration;
+    inline bool _good() noexcept;
+    inline void _next() noexcept;
+    inline void _stop() noexcept;
+    inline void _prepare_cache() noexcept;
+    inline void _report(_chronometro_impl::_time<Unit::automatic, 0> duration) noexcept;
+    friend _chronometro_impl::_measure_block;
+  };
+//*///------------------------------------------------------------------------------------------------------------------
+  class Measure::Iteration final
+  {
+  public:
+    // current measurement iteration
+    const unsigned value;
+
+    // pause measurements
+    inline void pause() noexcept;
+
+    // resume measurement
+    inline void start() noexcept;
+
+    // scoped pause/start of measurement
+    inline auto avoid() noexcept -> Stopwatch::_guard;
+
+  private:
+    friend Measure;
+    inline explicit Iteration(unsigned current_iteration, Measure* measurement) noexcept;
+    Measure* const _measurement;
+  };
+//*///------------------------------------------------------------------------------------------------------------------
+  class Regulator final
+  {
+  public:
+    struct Statistics
+    {
+      unsigned long long       ticks;       // deadlines reached
+      unsigned long long       overruns;    // deadlines already missed when waited for
+      std::chrono::nanoseconds mean_jitter; // mean lateness of the wake-ups
+      std::chrono::nanoseconds max_jitter;  // worst lateness of the wake-ups
+      double                   frequency;   // achieved ticks per second
+    };
+
+    // one tick per 'period', sleeping until 'spin' before each deadline and spinning the rest
+    inline explicit Regulator(
+      std::chrono::nanoseconds period, std::chrono::nanoseconds spin = std::chrono::microseconds(100)
+    ) noexcept;
+
+    // wait for the next deadline, return false if it was already missed
+    inline bool wait() noexcept;
+
+    // restart deadlines from now and clear statistics
+    inline void reset() noexcept;
+
+    // statistics since construction or last reset
+    inline auto statistics() const noexcept -> Statistics;
+
+  private:
+    const std::chrono::nanoseconds        _period;
+    const std::chrono::nanoseconds        _spin;
+    _chronometro_impl::_clock::time_point _goal;
+    _chronometro_impl::_clock::time_point _first;
+    _chronometro_impl::_clock::time_point _last;
+    unsigned long long                    _ticks    = 0;
+    unsigned long long                    _overruns = 0;
+    std::chrono::nanoseconds              _jitter   = {};
+    std::chrono::nanoseconds              _worst    = {};
+  };
+//*///------------------------------------------------------------------------------------------------------------------
+  class TimerWheel final
+  {
+  public:
+    struct Handle
+    {
+      std::uint32_t index;
+      std::uint32_t generation;
+    };
+
+    // wheel advancing by one 'tick' at a time
+    inline explicit TimerWheel(std::chrono::nanoseconds tick = std::chrono::milliseconds(1)) noexcept;
+
+    // call 'callback' once, 'delay' after the last poll
+    inline auto after(std::chrono::nanoseconds delay, std::function<void()> callback) -> Handle;
+
+    // call 'callback' every 'period', starting 'period' after the last poll
+    inline auto every(std::chrono::nanoseconds period, std::function<void()> callback) -> Handle;
+
+    // cancel a timer, return false if it already expired or was cancelled
+    inline bool cancel(Handle timer) noexcept;
+
+    // fire the expired callbacks with a single clock read, return how many were fired;
+    // an exception thrown by a callback propagates once its timer is rescheduled or released, as on return
+    inline auto poll() -> std::size_t;
+
+    // amount of pending timers
+    inline auto size() const noexcept -> std::size_t;
+
+  private:
+    static constexpr unsigned      _levels   = 4;
+    static constexpr unsigned      _bits     = 8;
+    static constexpr unsigned      _slots    = 1 << _bits;
+    static constexpr std::uint32_t _nil      = 0xFFFFFFFF;
+    static constexpr std::uint32_t _detached = _levels*_slots;
+
+    struct _node
+    {
+      std::function<void()> callback;
+      std::uint64_t         expiry;
+      std::uint64_t         period; // in ticks, 0 for one-shot timers
+      std::uint32_t         generation;
+      std::uint32_t         previous;
+      std::uint32_t         next;
+      std::uint32_t         list;
+      bool                  active;
+      bool                  cancelled;
+    };
+
+    const std::chrono::nanoseconds                  _tick;
+    const _chronometro_impl::_clock::time_point     _start   = _chronometro_impl::_clock::now();
+    std::uint64_t                                   _current = 0;
+    std::size_t                                     _pending = 0;
+    std::uint32_t                                   _free    = _nil;
+    std::vector<_node>                              _nodes;
+    std::uint32_t                                   _heads[_levels*_slots];
+
+    inline auto _ticks(std::chrono::nanoseconds duration) const noexcept -> std::uint64_t;
+    inline auto _allocate() -> std::uint32_t;
+    inline void _release(std::uint32_t index) noexcept;
+    inline void _link(std::uint32_t index) noexcept;
+    inline void _unlink(std::uint32_t index) noexcept;
+    inline auto _expire() -> std::size_t;
+  };
+//*///------------------------------------------------------------------------------------------------------------------
+  class Budget final
+  {
+  public:
+    static constexpr unsigned max_zones = 8;
+
+    struct Zone
+    {
+      const char*              name;
+      unsigned                 depth;    // nesting depth, 0 for zones directly inside the scope
+      std::chrono::nanoseconds offset;   // start relative to the scope's start
+      std::chrono::nanoseconds duration;
+    };
+
+    struct Event
+    {
+      std::chrono::nanoseconds              duration;
+      std::chrono::system_clock::time_point timestamp;
+      unsigned                              n_zones;
+      Zone                                  zones[max_zones];
+    };
+
+    // scope checked against the budget when destroyed
+    class Scope;
+
+    // record the 'capacity' slowest scopes exceeding 'budget'
+    inline explicit Budget(std::chrono::nanoseconds budget, std::size_t capacity = 16);
+
+    // also invoke 'callback' for every scope exceeding 'budget'
+    inline Budget(
+      std::chrono::nanoseconds budget, std::function<void(const Event&)> callback, std::size_t capacity = 16
+    );
+
+    // recorded events, slowest first
+    inline auto slowest() const -> std::vector<Event>;
+
+    // amount of scopes that exceeded the budget
+    inline auto exceeded() const noexcept -> unsigned long long;
+
+    // display recorded events
+    inline void report() const noexcept;
+
+  private:
+    const std::chrono::nanoseconds          _budget;
+    const std::size_t                       _capacity;
+    const std::function<void(const Event&)> _callback;
+    std::vector<Event>                      _events;
+    unsigned long long                      _exceeded = 0;
+    _stz_impl_MEMBER_MUTEX(_mtx)
+
+    inline void _capture(const Scope& scope, std::chrono::nanoseconds duration) noexcept;
+  };
+//*///------------------------------------------------------------------------------------------------------------------
+  class Budget::Scope final
+  {
+    class _zone;
+  public:
+    // start timing a scope against 'budget'
+    inline explicit Scope(Budget& budget) noexcept;
+
+    // time a nested zone until the returned guard is destroyed
+    inline auto zone(const char* name) noexcept -> _zone;
+
+    inline ~Scope() noexcept;
+
+  private:
+    Budget* const                               _owner;
+    const _chronometro_impl::_clock::time_point _start = _chronometro_impl::_clock::now();
+    unsigned                                    _n_zones = 0;
+    unsigned                                    _depth   = 0;
+    Zone                                        _zones[max_zones];
+    friend Budget;
+  };
+//*///------------------------------------------------------------------------------------------------------------------
+  class Budget::Scope::_zone final
+  {
+  public:
+    ~_zone() noexcept
+    {
+      if (_index < max_zones)
+      {
+        _scope->_zones[_index].duration = _chronometro_impl::_clock::now() - _start;
+      }
+
+      --_scope->_depth;
+    }
+
+  private:
+    explicit _zone(Scope* const scope_, const char* const name_) noexcept
+      : _scope(scope_)
+      , _index(scope_->_n_zones)
+    {
+      if (_index < max_zones)
+      {
+        _scope->_zones[_index] = {name_, _scope->_depth, _start - _scope->_start, {}};
+        ++_scope->_n_zones;
+      }
+
+      ++_scope->_depth;
+    }
+
+    Scope* const                                _scope;
+    const unsigned                              _index;
+    const _chronometro_impl::_clock::time_point _start = _chronometro_impl::_clock::now();
+
+    friend Scope;
+  };
+//*///------------------------------------------------------------------------------------------------------------------
+  namespace _chronometro_impl
+  {
+    struct _null_guard final
+    {
+      ~_null_guard() noexcept {}
+    };
+
+    // stand-ins for disabled instrumentation sites: no clock reads, no statics, no output
+    class _null_stopwatch final
+    {
+    public:
+      constexpr _null_stopwatch() noexcept = default;
+
+      auto split() const noexcept -> _time<Unit::automatic, 0> { return {std::chrono::nanoseconds::zero()}; }
+      auto total() const noexcept -> _time<Unit::automatic, 0> { return {std::chrono::nanoseconds::zero()}; }
+      void reset() const noexcept {}
+      void pause() const noexcept {}
+      void start() const noexcept {}
+      auto avoid() const noexcept -> _null_guard { return {}; }
+    };
+
+    class _null_measure final
+    {
+    public:
+      struct Iteration final
+      {
+        const unsigned value;
+
+        void pause() const noexcept {}
+        void start() const noexcept {}
+        auto avoid() const noexcept -> _null_guard { return {}; }
+      };
+
+      // fixtures still run, the statements may depend on them
+      class _iterator final
+      {
+      public:
+        explicit _iterator(_null_measure* const measure_) noexcept : _measure(measure_) {}
+
+        void operator++() const { _measure->_next(); }
+        auto operator!=(const _iterator&) const -> bool { return _measure->_good(); }
+        auto operator*() const noexcept -> Iteration { return {_measure->_iteration}; }
+
+      private:
+        _null_measure* const _measure;
+      };
+
+      explicit _null_measure(const unsigned iterations_ = 1, const char* = nullptr, const char* = nullptr) noexcept
+        : _iterations(iterations_)
+      {}
+
+      explicit _null_measure(const char*, const unsigned iterations_ = 1) noexcept
+        : _iterations(iterations_)
+      {}
+
+      void pause() const noexcept {}
+      void start() const noexcept {}
+      auto avoid() const noexcept -> _null_guard { return {}; }
+
+      auto cache(Cache) & noexcept -> _null_measure& { return *this; }
+      auto flush(const void*, std::size_t) & noexcept -> _null_measure& { return *this; }
+      auto pin(unsigned) & noexcept -> _null_measure& { return *this; }
+      auto numa(unsigned, unsigned) & noexcept -> _null_measure& { return *this; }
+      auto audit() & noexcept -> _null_measure& { return *this; }
+
+      auto setup(std::function<void(unsigned)> setup_) & noexcept -> _null_measure&
+      {
+        _setup = std::move(setup_);
+        return *this;
+      }
+
+      auto teardown(std::function<void(unsigned)> teardown_) & noexcept -> _null_measure&
+      {
+        _teardown = std::move(teardown_);
+        return *this;
+      }
+
+      auto prepare(const unsigned batch_, std::function<void(unsigned, unsigned)> prepare_) & noexcept
+        -> _null_measure&
+      {
+        _batch_size = batch_ ? batch_ : 1;
+        _batch      = std::move(prepare_);
+        return *this;
+      }
+
+      ~_null_measure()
+      {
+        // broken out of mid-iteration
+        if (_running and _teardown) _teardown(_iteration);
+      }
+
+      auto begin() noexcept -> _iterator
+      {
+        _iteration = 0;
+        return _iterator(this);
+      }
+
+      auto end() noexcept -> _iterator
+      {
+        return _iterator(this);
+      }
+
+    private:
+      const unsigned                          _iterations;
+      unsigned                                _iteration  = 0;
+      std::function<void(unsigned)>           _setup;
+      std::function<void(unsigned)>           _teardown;
+      std::function<void(unsigned, unsigned)> _batch;
+      unsigned                                _batch_size = 0;
+      bool                                    _running    = false;
+
+      auto _good() -> bool
+      {
+        if (_iteration == _iterations) return false;
+
+        if (_batch and _iteration % _batch_size == 0)
+        {
+          const unsigned remaining = _iterations - _iteration;
+          _batch(_iteration, (remaining < _batch_size) ? remaining : _batch_size);
+        }
+
+        if (_setup) _setup(_iteration);
+
+        _running = true;
+        return true;
+      }
+
+      void _next()
+      {
+        _running = false;
+        if (_teardown) _teardown(_iteration);
+
+        ++_iteration;
+      }
+    };
+
+    class _null_scope final
+    {
+    public:
+      template<typename B>
+      explicit _null_scope(B&) noexcept {}
+
+      auto zone(const char*) const noexcept -> _null_guard { return {}; }
+    };
+
+    struct _null_measure_block final
+    {
+      template<typename... T>
+      _null_measure_block(T... args) noexcept
+        : _measure(args...)
+      {}
+
+      template<typename L>
+      void operator=(L&& body_) &&
+      {
+        try
+        {
+          for (const auto iteration : _measure)
+          {
+            (void)iteration;
+            body_();
+          }
+        }
+        catch(_break&)
+        {}
+      }
+
+    private:
+      _null_measure _measure;
+    };
+
+    // discards the body without running it, there is no clock at level off to tell when it would be due
+    struct _null_if_elapsed final
+    {
+      template<typename L>
+      void operator=(L&&) && noexcept
+      {}
+    };
+  }
+
+  template<Level level>
+  struct Instrument final
+  {
+    static constexpr bool enabled = (level != Level::off) and (static_cast<int>(level) <= CHRONOMETRO_LEVEL);
+
+    using Stopwatch = typename std::conditional<enabled, stz::Stopwatch, _chronometro_impl::_null_stopwatch>::type;
+    using Measure   = typename std::conditional<enabled, stz::Measure,   _chronometro_impl::_null_measure>::type;
+    using Scope     = typename std::conditional<enabled, Budget::Scope,  _chronometro_impl::_null_scope>::type;
+  };
+//*///------------------------------------------------------------------------------------------------------------------
+  class Accumulator final
+  {
+  public:
+    struct Snapshot
+    {
+      unsigned long long       count;
+      std::chrono::nanoseconds sum;
+      std::chrono::nanoseconds min;
+      std::chrono::nanoseconds max;
+    };
+
+    inline Accumulator() noexcept;
+
+    // add a duration spanning 'count' events
+    inline void add(std::chrono::nanoseconds duration, unsigned long long count = 1) noexcept;
+
+    // add a duration obtained from a Stopwatch
+    template<Unit unit, unsigned n_decimals>
+    void add(_chronometro_impl::_time<unit, n_decimals> duration, unsigned long long count = 1) noexcept;
+
+    // sum, count, min and max over all threads, each shard read consistently
+    inline auto snapshot() const noexcept -> Snapshot;
+
+    // clear accumulated values, must not race with add()
+    inline void reset() noexcept;
+
+  private:
+    static constexpr unsigned _n_shards = 64;
+
+    // padded so that two shards' counters never share a cache line, whatever the alignment of the array
+    struct _shard
+    {
+      std::atomic<std::uint64_t> begun;
+      std::atomic<std::uint64_t> ended;
+      std::atomic<std::uint64_t> count;
+      std::atomic<std::int64_t>  sum;
+      std::atomic<std::int64_t>  min;
+      std::atomic<std::int64_t>  max;
+      char                       padding[128 - 6*8];
+    };
+
+    _shard _shards[_n_shards];
+
+    static inline auto _shard_index() noexcept -> unsigned;
+  };
+//*///------------------------------------------------------------------------------------------------------------------
+  class LiveMetric final
+  {
+  public:
+    struct Window
+    {
+      std::chrono::seconds     span;
+      unsigned long long       count;
+      double                   rate;  // recorded durations per second
+      std::chrono::nanoseconds p50;
+      std::chrono::nanoseconds p99;
+      std::chrono::nanoseconds max;
+    };
+
+    struct Snapshot
+    {
+      const char* name;
+      Window      windows[3]; // last 1 s, 10 s and 60 s
+    };
+
+    inline explicit LiveMetric(const char* name);
+
+    // record a duration
+    inline void record(std::chrono::nanoseconds duration) noexcept;
+
+    // record a duration obtained from a Stopwatch
+    template<Unit unit, unsigned n_decimals>
+    void record(_chronometro_impl::_time<unit, n_decimals> duration) noexcept;
+
+    // statistics over the last 'span', which is at most 60 s
+    inline auto window(std::chrono::seconds span) const noexcept -> Window;
+
+    // statistics over the last 1 s, 10 s and 60 s
+    inline auto snapshot() const noexcept -> Snapshot;
+
+  private:
+    // one slot per second, one more than the longest window so that the oldest second is complete
+    static constexpr unsigned _n_slots = 61;
+
+    struct _slot
+    {
+      std::int64_t                  second;
+      _chronometro_impl::_histogram histogram;
+    };
+
+    const char* const                           _name;
+    const _chronometro_impl::_clock::time_point _start = _chronometro_impl::_clock::now();
+    const std::unique_ptr<_slot[]>              _slots;
+    _stz_impl_MEMBER_MUTEX(_mtx)
+  };
+//*///------------------------------------------------------------------------------------------------------------------
+#if defined(_stz_impl_THREADSAFE)
+  class Reporter final
+  {
+  public:
+    // publish every 'interval', displaying through io::out() unless 'publish' is given
+    inline explicit Reporter(
+      std::chrono::nanoseconds interval, std::function<void(const LiveMetric::Snapshot&)> publish = nullptr
+    );
+
+    // publish 'metric' too, which must outlive the reporter
+    inline void add(const LiveMetric& metric);
+
+    // stop publishing
+    inline ~Reporter() noexcept;
+
+  private:
+    const std::chrono::nanoseconds                         _interval;
+    const std::function<void(const LiveMetric::Snapshot&)> _publish;
+    std::vector<const LiveMetric*>                         _metrics;
+    bool                                                   _stop = false;
+    std::mutex                                             _mtx;
+    std::condition_variable                                _wake;
+    std::thread                                            _thread;
+
+    inline void _run();
+  };
+#endif
+//*///------------------------------------------------------------------------------------------------------------------
+  class SharedMetrics final
+  {
+  public:
+    // handle to a metric of the segment, inert if it could not be registered
+    class Metric final
+    {
+    public:
+      // record a duration, serialized with other writers of the same metric, in any process
+      inline void record(std::chrono::nanoseconds duration) noexcept;
+
+      // record a duration obtained from a Stopwatch
+      template<Unit unit, unsigned n_decimals>
+      void record(_chronometro_impl::_time<unit, n_decimals> duration) noexcept;
+
+      // add to the metric's counter, which is independent from the recorded durations
+      inline void count(unsigned long long n = 1) noexcept;
+
+    private:
+      _chronometro_impl::_shared_metric* _metric;
+
+      inline explicit Metric(_chronometro_impl::_shared_metric* metric) noexcept;
+    friend SharedMetrics;
+    };
+
+    struct Snapshot
+    {
+      char                     name[48];
+      unsigned long long       counter;
+      unsigned long long       count;
+      std::chrono::nanoseconds sum;
+      std::chrono::nanoseconds min;
+      std::chrono::nanoseconds max;
+      std::chrono::nanoseconds p50;
+      std::chrono::nanoseconds p99;
+      bool                     torn; // read while a writer held it, because it died mid-update or never let go
+    };
+
+    // create the segment at 'path' with room for 'capacity' metrics, or attach to it if another process did with
+    // the same capacity; an incompatible one is reset in place with a warning, the file is never shrunk under the
+    // readers mapping it. A writer dying mid-update is detected through its pid, and the next writer of the metric
+    // takes over, leaving that one record partially applied
+    inline explicit SharedMetrics(const char* path, unsigned capacity = 64) noexcept;
+
+    SharedMetrics(const SharedMetrics&)                    = delete;
+    auto operator=(const SharedMetrics&) -> SharedMetrics& = delete;
+
+    // unmap the segment, leaving the file to its readers
+    inline ~SharedMetrics() noexcept;
+
+    // register a metric named 'name', truncated to 47 characters, or share the one already registered under it
+    inline auto metric(const char* name) noexcept -> Metric;
+
+    // read every registered metric of the segment at 'path', from any process
+    static inline auto read(const char* path) -> std::vector<Snapshot>;
+
+  private:
+    void*       _map  = nullptr;
+    std::size_t _size = 0;
+
+    inline auto _header() const noexcept -> _chronometro_impl::_shared_header&;
+    static inline auto _metrics(void* map) noexcept -> _chronometro_impl::_shared_metric*;
+  };
+//*///------------------------------------------------------------------------------------------------------------------
+#if defined(_stz_impl_THREADSAFE)
+  class TimedMutex final
+  {
+  public:
+    struct Times
+    {
+      std::chrono::nanoseconds total;
+      std::chrono::nanoseconds p50;
+      std::chrono::nanoseconds p99;
+      std::chrono::nanoseconds max;
+    };
+
+    struct Statistics
+    {
+      const char*        name;
+      unsigned long long acquisitions;
+      unsigned long long contentions; // acquisitions that found the mutex already locked
+      Times              wait;        // from the lock request to its acquisition
+      Times              hold;        // from the acquisition to the release
+    };
+
+    inline explicit TimedMutex(const char* name) noexcept;
+
+    TimedMutex(const TimedMutex&)                    = delete;
+    auto operator=(const TimedMutex&) -> TimedMutex& = delete;
+
+    // block until acquired, timing the wait
+    inline void lock() noexcept;
+
+    // acquire without blocking, counted as an uncontended acquisition when successful
+    inline auto try_lock() noexcept -> bool;
+
+    // release, recording the wait and hold times of this acquisition
+    inline void unlock() noexcept;
+
+    // statistics of every acquisition released so far, must not be called while holding the mutex
+    inline auto statistics() const noexcept -> Statistics;
+
+    // display statistics via io::out()
+    inline void report() const noexcept;
+
+  private:
+    const char* const                     _name;
+    mutable std::mutex                    _mtx;
+    _chronometro_impl::_clock::time_point _acquired;
+    std::chrono::nanoseconds              _waited;
+    unsigned long long                    _contentions = 0;
+    _chronometro_impl::_histogram         _wait;
+    _chronometro_impl::_histogram         _hold;
+  };
+#endif
+//*///------------------------------------------------------------------------------------------------------------------
+  // page-aligned buffer whose pages are bound to a NUMA node, or placed by the default policy where they cannot be
+  class NumaBuffer final
+  {
+  public:
+    // allocate 'size' bytes on 'node' and fault them in, empty if they could not be allocated
+    inline NumaBuffer(std::size_t size, unsigned node) noexcept;
+
+    NumaBuffer(const NumaBuffer&)                    = delete;
+    auto operator=(const NumaBuffer&) -> NumaBuffer& = delete;
+
+    inline ~NumaBuffer() noexcept;
+
+    inline auto data() const noexcept -> char*;
+    inline auto size() const noexcept -> std::size_t;
+
+    // whether the pages are bound to the requested node
+    inline auto bound() const noexcept -> bool;
+
+  private:
+    char*       _data  = nullptr;
+    std::size_t _size  = 0;
+    bool        _bound = false;
+  };
+//*///------------------------------------------------------------------------------------------------------------------
+#if defined(_stz_impl_COROUTINES)
+  namespace _chronometro_impl
+  {
+    template<typename A>
+    decltype(auto) _get_awaiter(A&& awaitable_)
+    {
+      if constexpr (requires { static_cast<A&&>(awaitable_).operator co_await(); })
+      {
+        return static_cast<A&&>(awaitable_).operator co_await();
+      }
+      else if constexpr (requires { operator co_await(static_cast<A&&>(awaitable_)); })
+      {
+        return operator co_await(static_cast<A&&>(awaitable_));
+      }
+      else
+      {
+        return static_cast<A&&>(awaitable_);
+      }
+    }
+
+    template<typename A>
+    class _timed_awaiter;
+  }
+
+  class Span final
+  {
+  public:
+    struct Times
+    {
+      std::chrono::nanoseconds active;      // running between suspensions
+      std::chrono::nanoseconds suspended;   // between suspension and resumption, possibly on another thread
+      unsigned long long       suspensions;
+    };
+
+    // start attributing time to running
+    inline Span() noexcept;
+
+    // await 'awaitable', attributing the time until resumption to suspension
+    template<typename A>
+    auto operator()(A&& awaitable) -> _chronometro_impl::_timed_awaiter<A&&>;
+
+    // times attributed so far
+    inline auto times() const noexcept -> Times;
+
+  private:
+    _chronometro_impl::_clock::time_point _start = _chronometro_impl::_clock::now();
+    _chronometro_impl::_clock::time_point _suspended_at;
+    std::chrono::nanoseconds              _suspended   = {};
+    unsigned long long                    _suspensions = 0;
+    bool                                  _is_suspended = false;
+
+    inline void _suspend() noexcept;
+    inline void _resume() noexcept;
+    inline void _cancel() noexcept;
+  template<typename>
+  friend class _chronometro_impl::_timed_awaiter;
+  };
+
+  // report times attributed by a Span
+  inline std::ostream& operator<<(std::ostream& ostream, const Span::Times& times) noexcept;
+
+  namespace _chronometro_impl
+  {
+    template<typename A>
+    class _timed_awaiter final
+    {
+    public:
+      _timed_awaiter(Span& span_, A awaitable_)
+        : _span(span_)
+        , _awaiter(_get_awaiter(static_cast<A>(awaitable_)))
+      {}
+
+      auto await_ready() -> bool
+      {
+        return _awaiter.await_ready();
+      }
+
+      // stamped before forwarding, the awaited operation may resume the coroutine on another thread at once;
+      // only when it declines to suspend, or resumes this very coroutine, is the span still ours to touch after
+      template<typename P>
+      auto await_suspend(const std::coroutine_handle<P> coroutine_)
+      {
+        using R = decltype(_awaiter.await_suspend(coroutine_));
+
+        _span._suspend();
+        if constexpr (std::is_void_v<R>)
+        {
+          _awaiter.await_suspend(coroutine_);
+        }
+        else if constexpr (std::is_same_v<R, bool>)
+        {
+          const bool suspends = _awaiter.await_suspend(coroutine_);
+          if (not suspends) _span._cancel();
+          return suspends;
+        }
+        else
+        {
+          const auto next = _awaiter.await_suspend(coroutine_);
+          if (std::coroutine_handle<>(next) == std::coroutine_handle<>(coroutine_)) _span._cancel();
+          return next;
+        }
+      }
+
+      decltype(auto) await_resume()
+      {
+        _span._resume();
+        return _awaiter.await_resume();
+      }
+
+    private:
+      Span& _span;
+      decltype(_get_awaiter(std::declval<A>())) _awaiter;
+    };
+  }
+#endif
+//*///------------------------------------------------------------------------------------------------------------------
+  namespace _chronometro_impl
+  {
+    struct _measure_block final
+    {
+      template<typename... T>
+      _measure_block(T... args)
+        : _measure(args...)
+      {}
+
+      template<typename L>
+      void operator=(L&& body_) &&
+      {
+        try
+        {
+          for (; _measure._good(); _measure._next())
+          {
+            body_();
+          }
+        }
+        catch(_break&)
+        {
+          _measure._stop();
+        } 
+      }
+
+    private:
+      Measure _measure;
+    };
+
+    template<std::chrono::nanoseconds::rep DURATION>
+    struct _if_elapsed final
+    {
+      static_assert(DURATION > 0, "stz: if_elapsed: 'DURATION' must be non-zero and positive.");
+
+      template<typename L>
+      void operator=(L&& body_) &&
+      {
+        static _chronometro_impl::_clock::time_point goal = {};
+        constexpr auto diff = std::chrono::nanoseconds(DURATION);
+
+        if (_chronometro_impl::_clock::now() > goal)
+        {
+          goal = _chronometro_impl::_clock::now() + diff;
+
+          body_();
+        }
+      }
+    };
+
+    template<unsigned long long N>
+    struct _loop_n_times final
+    {
+      static_assert(N > 0, "stz: if_elapsed: 'N' must be non-zero and positive.");
+
+      template<typename L>
+      void operator=(L&& body_) &&
+      {
+        try
+        {
+          for (unsigned long long n = N; n; --n)
+          {
+            body_();
+          }
+        }
+        catch(_break&) {}
+        
+      }
+    };
+
+    // not inlined, the standard implementation trips -Wstrict-overflow once inlined into the caller
+    _stz_impl_NOINLINE
+    inline void _sleep_for(const std::chrono::nanoseconds duration_) noexcept
+    {
+#   if defined(_stz_impl_THREADSAFE)
+      std::this_thread::sleep_for(duration_);
+#   elif defined(__unix__)
+      ::usleep(static_cast<useconds_t>(duration_.count()/1000));
+#   else
+      const auto goal = _clock::now() + duration_;
+      while (_clock::now() < goal);
+#   endif
+    }
+
+    // let another thread or process make progress while spinning
+    inline void _yield() noexcept
+    {
+#   if defined(_stz_impl_THREADSAFE)
+      std::this_thread::yield();
+#   endif
+    }
+
+    struct _loop_at_rate final
+    {
+      explicit _loop_at_rate(const std::chrono::nanoseconds::rep period_) noexcept
+        : _regulator(std::chrono::nanoseconds(period_))
+      {}
+
+      template<typename L>
+      void operator=(L&& body_) &&
+      {
+        try
+        {
+          while (true)
+          {
+            _regulator.wait();
+            body_();
+          }
+        }
+        catch(_break&) {}
+
+        const auto statistics = _regulator.statistics();
+
+        char frequency[32];
+        std::sprintf(frequency, "%.1f Hz", statistics.frequency);
+
+        _stz_impl_DECLARE_LOCK(_out_mtx);
+        io::out() << "loop_at_rate: " << statistics.ticks << " ticks at " << frequency << ", " << statistics.overruns
+          << " overruns, jitter mean " << _time_as_cstring(_time<Unit::automatic, 1>{statistics.mean_jitter})
+          << ", max " << _time_as_cstring(_time<Unit::automatic, 1>{statistics.max_jitter}) << '\n';
+      }
+
+    private:
+      Regulator _regulator;
+    };
+
+    template<unsigned long long N, unsigned long long offset>
+    struct _if_n_pass final
+    {
+      template<typename L>
+      void operator=(L&& body_) &&
+      {
+        static unsigned long long pass = N - offset - 1;
+        if (++pass >= N)
+        {
+          pass = 0;
+
+          body_();
+        }
+      }
+    };
+
+    struct _break final : public std::exception
+    {
+    public:
+      _break(const char* caller_) noexcept
+        : _message(std::string("stz: break_now: broke from '").append(caller_).append("'."))
+      {}
+
+      const char* what() const noexcept override
+      {
+        return _message.c_str();
+      }
+
+    private:
+      const std::string _message;
+    };
+
+    struct _variant final
+    {
+      void              (*invoke)(void*);
+      void*               body;
+      unsigned long long  batch;
+      std::vector<double> samples; // nanoseconds per invocation
+    };
+
+    template<typename L>
+    void _invoke(void* const body_)
+    {
+      (*static_cast<L*>(body_))();
+    }
+
+    inline void _invoke_nothing(void*) noexcept {}
+
+    // not inlined, so that every variant is invoked through the same indirect call
+    _stz_impl_NOINLINE
+    inline auto _sample(const _variant& variant_) -> double
+    {
+      const auto start = _clock::now();
+
+      for (auto n = variant_.batch; n; --n)
+      {
+        variant_.invoke(variant_.body);
+      }
+
+      const auto stop = _clock::now();
+
+      return static_cast<double>(std::chrono::nanoseconds(stop - start).count())/static_cast<double>(variant_.batch);
+    }
+
+    // two-sided 95% quantile of the Student t distribution
+    inline auto _student_t95(const std::size_t dof_) noexcept -> double
+    {
+      static constexpr double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228, 2.201, 2.179, 2.160, 2.145, 2.131,
+        2.120,  2.110, 2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+      };
+
+      return (dof_ == 0) ? 0 : (dof_ <= 30) ? table[dof_ - 1] : 1.960;
+    }
+
+    inline auto _as_time(const double nanoseconds_) noexcept -> _time<Unit::automatic, 1>
+    {
+      return {std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(nanoseconds_ + 0.5))};
+    }
+
+    inline auto _as_time(const std::chrono::nanoseconds nanoseconds_) noexcept -> _time<Unit::automatic, 1>
+    {
+      return {nanoseconds_};
+    }
+
+    inline void _compare(_variant* const variants_, const std::size_t n_variants_, const unsigned rounds_)
+    {
+      // cost of the indirect call through which every body is invoked, subtracted from their samples
+      _variant nothing = {&_invoke_nothing, nullptr, 4096, {}};
+      double   overhead = std::numeric_limits<double>::max();
+      for (unsigned k = 0; k < 8; ++k)
+      {
+        overhead = std::min(overhead, _sample(nothing));
+      }
+
+      std::vector<std::size_t> order(n_variants_);
+      for (std::size_t k = 0; k < n_variants_; ++k)
+      {
+        order[k] = k;
+      }
+
+      std::minstd_rand generator(static_cast<std::minstd_rand::result_type>(_clock::now().time_since_epoch().count()));
+
+      unsigned rounds = 0;
+      try
+      {
+        // batch invocations so that each sample spans atleast 10 us, well above clock resolution
+        for (std::size_t k = 0; k < n_variants_; ++k)
+        {
+          variants_[k].batch = 1;
+          const double once  = std::max(_sample(variants_[k]), 1.0);
+
+          variants_[k].batch = static_cast<unsigned long long>(std::min(std::max(10000/once, 1.0), 1048576.0));
+          variants_[k].samples.reserve(rounds_);
+        }
+
+        for (; rounds < rounds_; ++rounds)
+        {
+          std::shuffle(order.begin(), order.end(), generator);
+
+          for (const auto k : order)
+          {
+            const double sample = _sample(variants_[k]) - overhead;
+            variants_[k].samples.push_back(sample > 0 ? sample : 0);
+          }
+        }
+      }
+      catch (_break&)
+      {
+        // rounds are paired, a partial one is discarded
+        for (std::size_t k = 0; k < n_variants_; ++k)
+        {
+          variants_[k].samples.resize(rounds);
+        }
+      }
+
+      _stz_impl_DECLARE_LOCK(_out_mtx);
+      io::out() << "compare: " << n_variants_ << " variants, " << rounds << " interleaved rounds, "
+        << _time_as_cstring(_as_time(overhead)) << " call overhead subtracted" << std::endl;
+
+      for (std::size_t k = 0; k < n_variants_; ++k)
+      {
+        auto sorted = variants_[k].samples;
+        std::sort(sorted.begin(), sorted.end());
+
+        double mean = 0;
+        for (const auto sample : sorted) mean += sample;
+        mean /= static_cast<double>(std::max<std::size_t>(sorted.size(), 1));
+
+        double variance = 0;
+        for (const auto sample : sorted) variance += (sample - mean)*(sample - mean);
+        variance /= static_cast<double>(std::max<std::size_t>(sorted.size(), 2) - 1);
+
+        const double median = sorted.empty() ? 0 : sorted[sorted.size()/2];
+
+        io::out() << "  #" << k << ": median " << _time_as_cstring(_as_time(median));
+        io::out() << ", mean "   << _time_as_cstring(_as_time(mean));
+        io::out() << ", stddev " << _time_as_cstring(_as_time(std::sqrt(variance)));
+
+        if (k == 0)
+        {
+          io::out() << " (baseline)" << std::endl;
+          continue;
+        }
+
+        // rounds are paired, so drift affects both terms of each ratio alike
+        std::vector<double> ratios;
+        ratios.reserve(rounds_);
+        for (std::size_t round = 0; round < variants_[k].samples.size(); ++round)
+        {
+          if (variants_[0].samples[round] > 0 and variants_[k].samples[round] > 0)
+          {
+            ratios.push_back(std::log(variants_[0].samples[round]/variants_[k].samples[round]));
+          }
+        }
+
+        double log_mean = 0;
+        for (const auto ratio : ratios) log_mean += ratio;
+        log_mean /= static_cast<double>(std::max<std::size_t>(ratios.size(), 1));
+
+        double log_variance = 0;
+        for (const auto ratio : ratios) log_variance += (ratio - log_mean)*(ratio - log_mean);
+        log_variance /= static_cast<double>(std::max<std::size_t>(ratios.size(), 2) - 1);
+
+        const double margin = _student_t95(ratios.size() - (ratios.empty() ? 0 : 1))
+          * std::sqrt(log_variance/static_cast<double>(std::max<std::size_t>(ratios.size(), 1)));
+
+        char speedup[96];
+        std::sprintf(speedup, ", speedup %.3fx [95%% CI %.3fx, %.3fx]",
+          std::exp(log_mean), std::exp(log_mean - margin), std::exp(log_mean + margin));
+
+        io::out() << speedup << std::endl;
+      }
+    }
+
+    using _samples = std::vector<std::chrono::nanoseconds::rep>;
+
+    // nanoseconds taken by each iteration, until all are done or the body breaks
+    inline void _run_iterations(void (*invoke_)(void*), void* const body_, unsigned iterations_, _samples& samples_)
+    {
+      samples_.reserve(iterations_);
+
+      try
+      {
+        for (; iterations_; --iterations_)
+        {
+          const auto start = _clock::now();
+          invoke_(body_);
+          const auto stop  = _clock::now();
+
+          samples_.push_back(std::chrono::nanoseconds(stop - start).count());
+        }
+      }
+      catch (_break&) {}
+    }
+
+    inline void _report_isolation(const std::vector<_samples>& processes_, const unsigned iterations_) noexcept
+    {
+      _stz_impl_DECLARE_LOCK(_out_mtx);
+      io::out() << "isolate: " << processes_.size() << " processes x " << iterations_ << " iterations" << std::endl;
+
+      std::vector<double> means;
+      double pooled_variance = 0;
+      std::size_t dof        = 0;
+
+      for (std::size_t p = 0; p < processes_.size(); ++p)
+      {
+        const auto& samples = processes_[p];
+        if (samples.empty()) continue;
+
+        double mean = 0;
+        for (const auto sample : samples) mean += static_cast<double>(sample);
+        mean /= static_cast<double>(samples.size());
+
+        double squares = 0;
+        for (const auto sample : samples)
+        {
+          squares += (static_cast<double>(sample) - mean)*(static_cast<double>(sample) - mean);
+        }
+
+        const double variance = squares/static_cast<double>(std::max<std::size_t>(samples.size(), 2) - 1);
+
+        means.push_back(mean);
+        pooled_variance += squares;
+        dof             += samples.size() - 1;
+
+        io::out() << "  process " << p << ": mean " << _time_as_cstring(_as_time(mean));
+        io::out() << ", stddev " << _time_as_cstring(_as_time(std::sqrt(variance))) << std::endl;
+      }
+
+      if (means.empty()) return;
+
+      double grand_mean = 0;
+      for (const auto mean : means) grand_mean += mean;
+      grand_mean /= static_cast<double>(means.size());
+
+      double between_variance = 0;
+      for (const auto mean : means) between_variance += (mean - grand_mean)*(mean - grand_mean);
+      between_variance /= static_cast<double>(std::max<std::size_t>(means.size(), 2) - 1);
+
+      pooled_variance /= static_cast<double>(std::max<std::size_t>(dof, 1));
+
+      char percent[32];
+
+      std::sprintf(percent, " (%.1f%%)", grand_mean > 0 ? 100*std::sqrt(between_variance)/grand_mean : 0.0);
+      io::out() << "  between processes: mean " << _time_as_cstring(_as_time(grand_mean));
+      io::out() << ", stddev " << _time_as_cstring(_as_time(std::sqrt(between_variance))) << percent << std::endl;
+
+      std::sprintf(percent, " (%.1f%%)", grand_mean > 0 ? 100*std::sqrt(pooled_variance)/grand_mean : 0.0);
+      io::out() << "  within processes: pooled stddev " << _time_as_cstring(_as_time(std::sqrt(pooled_variance)))
+        << percent << std::endl;
+    }
+
+#if defined(__unix__)
+    // write all of 'size_' bytes, resuming after signals interrupt the write
+    inline auto _write_all(const int fd_, const void* const data_, std::size_t size_) noexcept -> bool
+    {
+      const char* data = static_cast<const char*>(data_);
+      while (size_)
+      {
+        const auto written = ::write(fd_, data, size_);
+        if (written < 0 and errno == EINTR) continue;
+        if (written <= 0) return false;
+
+        data  += written;
+        size_ -= static_cast<std::size_t>(written);
+      }
+
+      return true;
+    }
+
+    // read until end of file, resuming after signals interrupt the read
+    inline auto _read_all(const int fd_, std::vector<char>& bytes_) -> bool
+    {
+      char buffer[4096];
+      for (;;)
+      {
+        const auto received = ::read(fd_, buffer, sizeof(buffer));
+        if (received < 0 and errno == EINTR) continue;
+        if (received <= 0) return received == 0;
+
+        bytes_.insert(bytes_.end(), buffer, buffer + received);
+      }
+    }
+#endif
+
+    inline void _isolate(
+      void (*invoke_)(void*), void* const body_, const unsigned processes_, const unsigned iterations_
+    )
+    {
+      std::vector<_samples> processes;
+
+#if defined(__unix__)
+      for (unsigned p = 0; p < processes_; ++p)
+      {
+        {
+          _stz_impl_DECLARE_LOCK(_out_mtx);
+          io::out().flush();
+          std::fflush(nullptr);
+        }
+
+        int fds[2];
+        if _stz_impl_ABNORMAL(::pipe(fds) != 0)
+        {
+          _stz_impl_DECLARE_LOCK(_out_mtx);
+          io::wrn() << "stz: isolate_block: could not create pipe" << std::endl;
+          break;
+        }
+
+        const pid_t pid = ::fork();
+
+        if (pid == 0)
+        {
+          // the child must never unwind back into the caller's code, which would run twice
+          try
+          {
+            ::close(fds[0]);
+
+            // fork preserves the parent's address space layout, so only shift the heap and stack by random offsets
+            std::minstd_rand generator(static_cast<std::minstd_rand::result_type>(
+              _clock::now().time_since_epoch().count() ^ ::getpid()));
+
+            const std::unique_ptr<char[]> heap_padding(new char[16*(generator() % 4096) + 1]);
+            heap_padding[0] = 0;
+#         if defined(__GNUC__)
+            const std::size_t    stack_size    = 16*(generator() % 256) + 1;
+            volatile char* const stack_padding = static_cast<volatile char*>(__builtin_alloca(stack_size));
+            stack_padding[0] = 0;
+#         endif
+
+            _samples samples;
+            _run_iterations(invoke_, body_, iterations_, samples);
+
+            // prefixed with their count, so that the parent tells a complete payload from a truncated one
+            const std::uint64_t count = samples.size();
+            if (not _write_all(fds[1], &count, sizeof(count))
+              or not _write_all(fds[1], samples.data(), samples.size()*sizeof(_samples::value_type)))
+            {
+              ::_exit(1);
+            }
+
+            io::out().flush();
+            std::fflush(nullptr);
+          }
+          catch (...)
+          {
+            ::_exit(1);
+          }
+
+          ::_exit(0);
+        }
+
+        ::close(fds[1]);
+
+        if _stz_impl_ABNORMAL(pid < 0)
+        {
+          ::close(fds[0]);
+
+          _stz_impl_DECLARE_LOCK(_out_mtx);
+          io::wrn() << "stz: isolate_block: could not fork" << std::endl;
+          break;
+        }
+
+        std::vector<char> bytes;
+        const bool received = _read_all(fds[0], bytes);
+        ::close(fds[0]);
+
+        int   status = 0;
+        pid_t reaped;
+        do
+        {
+          reaped = ::waitpid(pid, &status, 0);
+        } while (reaped < 0 and errno == EINTR);
+
+        std::uint64_t count = 0;
+        if (bytes.size() >= sizeof(count))
+        {
+          std::memcpy(&count, bytes.data(), sizeof(count));
+        }
+
+        if _stz_impl_ABNORMAL(reaped != pid or not WIFEXITED(status) or WEXITSTATUS(status) != 0)
+        {
+          _stz_impl_DECLARE_LOCK(_out_mtx);
+          io::wrn() << "stz: isolate_block: process " << p << " failed, its samples are discarded" << std::endl;
+          continue;
+        }
+
+        if _stz_impl_ABNORMAL(not received or bytes.size() < sizeof(count)
+          or (bytes.size() - sizeof(count))/sizeof(_samples::value_type) != count
+          or (bytes.size() - sizeof(count))%sizeof(_samples::value_type) != 0)
+        {
+          _stz_impl_DECLARE_LOCK(_out_mtx);
+          io::wrn() << "stz: isolate_block: process " << p << " sent incomplete samples, they are discarded"
+            << std::endl;
+          continue;
+        }
+
+        _samples samples(static_cast<std::size_t>(count));
+        std::copy(bytes.data() + sizeof(count), bytes.data() + bytes.size(), reinterpret_cast<char*>(samples.data()));
+        processes.push_back(std::move(samples));
+      }
+#else
+      {
+        _stz_impl_DECLARE_LOCK(_out_mtx);
+        io::wrn() << "stz: isolate_block: cannot fork on this platform, measuring in-process" << std::endl;
+      }
+
+      for (unsigned p = 0; p < processes_; ++p)
+      {
+        _samples samples;
+        _run_iterations(invoke_, body_, iterations_, samples);
+        processes.push_back(std::move(samples));
+      }
+#endif
+
+      _report_isolation(processes, iterations_);
+    }
+
+    struct _isolate_block final
+    {
+      _isolate_block(const unsigned processes_, const unsigned iterations_ = 1) noexcept
+        : _processes(processes_)
+        , _iterations(iterations_)
+      {}
+
+      template<typename L>
+      void operator=(L&& body_) &&
+      {
+        _isolate(&_invoke<typename std::remove_reference<L>::type>, &body_, _processes, _iterations);
+      }
+
+    private:
+      const unsigned _processes;
+      const unsigned _iterations;
+    };
+  }
+//*///------------------------------------------------------------------------------------------------------------------
+  class Stopwatch::_guard final
+  {
+  public:
+    ~_guard() noexcept
+    {
+      _stopwatch->start();
+    }
+    
+  private:
+    explicit _guard(Stopwatch* const stopwatch_) noexcept
+      : _stopwatch(stopwatch_)
+    {
+      _stopwatch->pause();
+    }
+
+    Stopwatch* const _stopwatch;
+    
+    friend Stopwatch;
+  };
+//*///------------------------------------------------------------------------------------------------------------------
+  class Measure::_iterator final
+  {
+  public:
+    constexpr _iterator() noexcept = default;
+
+    _iterator(Measure* const measure_) noexcept
+      : _measure(measure_)
+    {}
+
+    void operator++() const noexcept
+    {
+      _measure->_next();
+    }
+
+    bool operator!=(const _iterator&) const noexcept
+    {
+      return _measure->_good();
+    }
+
+    Iteration operator*() const noexcept
+    {
+      return _measure->_view();
+    }
+  private:
+    Measure* const _measure = nullptr;
+  };
+//*///------------------------------------------------------------------------------------------------------------------
+  template<Unit unit, unsigned n_decimals>
+  auto format_duration(
+    const _chronometro_impl::_time<unit, n_decimals> time_, char* const buffer_, const std::size_t size_
+  ) noexcept -> std::size_t
+  {
+    if _stz_impl_ABNORMAL(size_ == 0) return 0;
+
+    if _stz_impl_EXPECTED(size_ >= 32)
+    {
+      return _chronometro_impl::_write_time(buffer_, time_);
+    }
+
+    // truncated to fit
+    char buffer[32];
+    auto length = _chronometro_impl::_write_time(buffer, time_);
+    length = (length < size_) ? length : size_ - 1;
+    std::memcpy(buffer_, buffer, length);
+    buffer_[length] = '\0';
+
+    return length;
+  }
+
+  template<Unit unit, unsigned n_decimals>
+  auto format_duration(
+    const std::chrono::nanoseconds duration_, char* const buffer_, const std::size_t size_
+  ) noexcept -> std::size_t
+  {
+    return format_duration(_chronometro_impl::_time<unit, n_decimals>{duration_}, buffer_, size_);
+  }
+//*///------------------------------------------------------------------------------------------------------------------
+  template<Unit unit>
+  void sleep(const unsigned long long amount_) noexcept
+  {
+    const auto span = std::chrono::nanoseconds{_chronometro_impl::_unit_helper<unit>::factor * amount_};
+    const auto goal = span + _chronometro_impl::_clock::now();
+    while (_chronometro_impl::_clock::now() < goal);
+  }
+
+  template<typename R, typename P>
+  void sleep(const std::chrono::duration<R, P> duration_) noexcept
+  {
+    const auto goal = _chronometro_impl::_clock::now() + duration_;
+    while (_chronometro_impl::_clock::now() < goal);
+  }
+
+  template<>
+  void sleep<Unit::automatic>(unsigned long long) noexcept = delete;
+//*///------------------------------------------------------------------------------------------------------------------
+  template<typename... L>
+  void compare(const unsigned rounds_, L&&... bodies_)
+  {
+    static_assert(sizeof...(L) >= 2, "stz: compare: atleast two bodies are required.");
+
+    _chronometro_impl::_variant variants[] = {
+      {
+        &_chronometro_impl::_invoke<typename std::remove_reference<L>::type>,
+        const_cast<void*>(static_cast<const void*>(&bodies_)), 1, {}
+      }...
+    };
+
+    _chronometro_impl::_compare(variants, sizeof...(L), rounds_);
+  }
+//*///------------------------------------------------------------------------------------------------------------------
+# undef  if_elapsed
+  void   if_elapsed();
+#if CHRONOMETRO_LEVEL > 0
+# define if_elapsed(DURATION) _chronometro_impl::_if_elapsed<stz::_chronometro_impl::_to_ns(DURATION)>() = [&]() -> void
+#else
+# define if_elapsed(DURATION) _chronometro_impl::_null_if_elapsed() = [&]() -> void
+#endif
+//*///------------------------------------------------------------------------------------------------------------------
+# undef  loop_n_times
+  void   loop_n_times();
+# define loop_n_times(N) _chronometro_impl::_loop_n_times<N>() = [&]() -> void
+//*///------------------------------------------------------------------------------------------------------------------
+# undef  loop_at_rate
+  void   loop_at_rate();
+# define loop_at_rate(PERIOD) _chronometro_impl::_loop_at_rate(stz::_chronometro_impl::_to_ns(PERIOD)) = [&]() -> void
+//*///------------------------------------------------------------------------------------------------------------------
+# undef  if_n_pass
+  void   if_n_pass();
+# define if_n_pass(...) _chronometro_impl::_if_n_pass<__VA_ARGS__>() = [&]() -> void
+//*///------------------------------------------------------------------------------------------------------------------
+# undef  break_now
+  inline
+  void   break_now(const char* const caller_) { throw _chronometro_impl::_break(caller_); }
+# define break_now break_now(__func__)
+//*///------------------------------------------------------------------------------------------------------------------
+# undef  break_after_n
+  void   break_after_n();
+# define break_after_n(...) if_n_pass(__VA_ARGS__) { stz::break_now; }
+//*///------------------------------------------------------------------------------------------------------------------
+  _stz_impl_NODISCARD_REASON("split: not using the return value makes no sens.")
+  auto Stopwatch::split() noexcept -> _chronometro_impl::_time<Unit::automatic, 0>
+  {
+    const auto now = _chronometro_impl::_clock::now();
+
+    auto split_duration = _duration_split;
+    _duration_split     = {};
+
+    if _stz_impl_EXPECTED(not _paused)
+    {
+      _duration_total += now - _previous;
+      split_duration  += now - _previous;
+
+      _previous = _chronometro_impl::_clock::now();
+    }
+
+    return _chronometro_impl::_time<Unit::automatic, 0>{split_duration};
+  }
+
+  _stz_impl_NODISCARD_REASON("total: not using the return value makes no sens.")
+  auto Stopwatch::total() noexcept -> _chronometro_impl::_time<Unit::automatic, 0>
+  {
+    const auto now = _chronometro_impl::_clock::now();
+
+    auto total_duration = _duration_total;
+
+    if _stz_impl_EXPECTED(not _paused)
+    {
+      total_duration += now - _previous;
+
+      _duration_split = {};
+      _duration_total = {};
+    }
+
+    return _chronometro_impl::_time<Unit::automatic, 0>{total_duration};
+  }
+
+  void Stopwatch::reset() noexcept
+  {
+    _duration_total = {};
+    _duration_split = {};
+
+    if (_paused) return;
+
+    _previous = _chronometro_impl::_clock::now();
+  }
+
+  void Stopwatch::pause() noexcept
+  {
+    const auto now = _chronometro_impl::_clock::now();
+
+    if _stz_impl_ABNORMAL(_paused) return;
+
+    _paused = true;
+
+    _duration_total += now - _previous;
+    _duration_split += now - _previous;
+  }
+
+  void Stopwatch::start() noexcept
+  {
+    if _stz_impl_EXPECTED(_paused)
+    {
+      _paused = false;
+
+      _previous = _chronometro_impl::_clock::now();
+    }
+  }
+
+  auto Stopwatch::avoid() noexcept -> _guard
+  {
+    return _guard(this);
+  }
+//*///------------------------------------------------------------------------------------------------------------------
+  Measure::Measure(const unsigned iterations_) noexcept
+    : _iterations(iterations_)
+    , _total_fmt((_iterations > 1) ? "total elapsed time: %ms [avg = %Dus]" : "total elapsed time: %ms")
+  {}
+
+  Measure::Measure(const unsigned iterations_, const char* const iteration_format_) noexcept
+    : _iterations(iterations_)
+    , _split_fmt(iteration_format_ && *iteration_format_ ? iteration_format_ : nullptr)
+    , _total_fmt((_iterations > 1) ? "total elapsed time: %ms [avg = %Dus]" : "total elapsed time: %ms")
+  {}
+
+  Measure::Measure(
+    const unsigned iterations_, const char* const iteration_format_, const char* const total_format_
+  ) noexcept
+    : _iterations(iterations_)
+    , _split_fmt(iteration_format_ && *iteration_format_ ? iteration_format_ : nullptr)
+    , _total_fmt(total_format_     && *total_format_     ? total_format_     : nullptr)
+  {}
+
+  Measure::Measure(const char* const total_format_) noexcept
+    : _total_fmt(total_format_ && *total_format_ ? total_format_ : nullptr)
+  {}
+
+  Measure::Measure(const char* const total_format_, const unsigned iterations_) noexcept
+    : _iterations(iterations_)
+    , _total_fmt(total_format_ && *total_format_ ? total_format_ : nullptr)
+  {}
+
+  void Measure::pause() noexcept
+  {
+    _stopwatch.pause();
+  }
+
+  void Measure::start() noexcept
+  {
+    _stopwatch.start();
+  }
+
+  auto Measure::avoid() noexcept -> Stopwatch::_guard
+  {
+    return _stopwatch.avoid();
+  }
+
+  auto Measure::cache(const Cache mode_) & noexcept -> Measure&
+  {
+    _cache = mode_;
+
+    return *this;
+  }
+
+  auto Measure::flush(const void* const data_, const std::size_t size_) & noexcept -> Measure&
+  {
+    _cache = Cache::flush;
+    _flushed.emplace_back(data_, size_);
+
+    return *this;
+  }
+
+  auto Measure::pin(const unsigned cpu_) & noexcept -> Measure&
+  {
+    _cpu = static_cast<int>(cpu_);
+
+    return *this;
+  }
+
+  auto Measure::numa(const unsigned cpu_node_, const unsigned memory_node_) & noexcept -> Measure&
+  {
+    _cpu_node    = static_cast<int>(cpu_node_);
+    _memory_node = static_cast<int>(memory_node_);
+
+    return *this;
+  }
+
+  auto Measure::audit() & noexcept -> Measure&
+  {
+    _audit = true;
+
+    return *this;
+  }
+
+  auto Measure::environment() const noexcept -> const Environment&
+  {
+    return _environment;
+  }
+
+  auto Measure::setup(std::function<void(unsigned)> setup_) & noexcept -> Measure&
+  {
+    _setup = std::move(setup_);
+
+    return *this;
+  }
+
+  auto Measure::teardown(std::function<void(unsigned)> teardown_) & noexcept -> Measure&
+  {
+    _teardown = std::move(teardown_);
+
+    return *this;
+  }
+
+  auto Measure::prepare(const unsigned batch_, std::function<void(unsigned, unsigned)> prepare_) & noexcept
+    -> Measure&
+  {
+    _batch_size = batch_ ? batch_ : 1;
+    _batch      = std::move(prepare_);
+
+    return *this;
+  }
+
+  auto Measure::begin() noexcept -> _iterator
+  {
+    _remaining         = _iterations;
+    _allocations_total = {};
+
+    if (_cpu >= 0 or _cpu_node >= 0)
+    {
+#   if defined(__linux__)
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+
+      if (_cpu >= 0)
+      {
+        CPU_SET(_cpu, &cpus);
+      }
+      else
+      {
+        _chronometro_impl::_node_cpus(static_cast<unsigned>(_cpu_node), cpus);
+      }
+
+      if (CPU_COUNT(&cpus) == 0
+       or ::sched_getaffinity(0, sizeof(_affinity), &_affinity) != 0
+       or ::sched_setaffinity(0, sizeof(cpus), &cpus) != 0)
+      {
+        _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
+        io::wrn() << "stz: Measure: could not pin thread to " << (_cpu >= 0 ? "cpu " : "the cpus of node ")
+          << (_cpu >= 0 ? _cpu : _cpu_node) << std::endl;
+        _cpu      = -1;
+        _cpu_node = -1;
+      }
+#   else
+      _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
+      io::wrn() << "stz: Measure: thread pinning is not supported on this platform" << std::endl;
+      _cpu      = -1;
+      _cpu_node = -1;
+#   endif
+    }
+
+    if (_memory_node >= 0)
+    {
+#   if defined(__linux__)
+      // the thread's own policy is restored afterwards, rather than reset to the default one
+      if (not _chronometro_impl::_get_mempolicy(_memory_policy)
+       or not _chronometro_impl::_set_mempolicy(static_cast<unsigned>(_memory_node)))
+#   endif
+      {
+        _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
+        io::wrn() << "stz: Measure: could not bind allocations to node " << _memory_node
+          << ", they are placed by the default policy" << std::endl;
+        _memory_node = -1;
+      }
+    }
+
+    if (_audit)
+    {
+      _environment = stz::environment(_cpu);
+
+      _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
+
+      if (_environment.governor[0] and std::strcmp(_environment.governor, "performance") != 0)
+      {
+        io::wrn() << "stz: Measure: cpu " << _environment.cpu << " frequency governor is '"
+          << _environment.governor << "' instead of 'performance'" << std::endl;
+      }
+
+      if (_environment.turbo == 1)
+      {
+        io::wrn() << "stz: Measure: turbo is enabled, frequency may vary during the run" << std::endl;
+      }
+
+      if (_environment.sibling_load > 0.1)
+      {
+        io::wrn() << "stz: Measure: SMT siblings of cpu " << _environment.cpu << " are "
+          << static_cast<int>(_environment.sibling_load*100) << "% busy" << std::endl;
+      }
+
+      if (_environment.load_average > 0.5*_environment.cpus)
+      {
+        io::wrn() << "stz: Measure: load average is " << _environment.load_average << " for "
+          << _environment.cpus << " cpus" << std::endl;
+      }
+    }
+
+    if (_cache != Cache::warm and _total_fmt)
+    {
+      const auto& sizes = cache_sizes();
+
+      _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
+      io::dbg() << "cache: L1d " << (sizes.l1d >> 10) << " KiB, L2 " << (sizes.l2 >> 10) << " KiB, L3 "
+        << (sizes.l3 >> 10) << " KiB, line " << sizes.line << " B ["
+        << (_cache == Cache::evict ? "evicting" : "flushing") << " before each iteration]" << std::endl;
+    }
+
+    // only ever started around an iteration's statements
+    _stopwatch.pause();
+    _stopwatch.reset();
+
+    return _iterator(this);
+  }
+
+  auto Measure::end() const noexcept -> _iterator
+  {
+    return _iterator();
+  }
+
+  Measure::~Measure() noexcept
+  {
+    if _stz_impl_ABNORMAL(_remaining) _stop();
+  }
+
+  auto Measure::_view() noexcept -> Iteration
+  {
+    return Iteration(_iterations - _remaining, this);
+  }
+
+  bool Measure::_good() noexcept
+  {
+    if _stz_impl_EXPECTED(_remaining)
+    {
+      const unsigned iteration = _iterations - _remaining;
+
+      if (_batch and iteration % _batch_size == 0)
+      {
+        _batch(iteration, (_remaining < _batch_size) ? _remaining : _batch_size);
+      }
+
+      if (_setup)
+      {
+        _setup(iteration);
+      }
+
+      _prepare_cache();
+      _allocations_start = _chronometro_impl::_allocation_counters();
+
+      // last, so that nothing but the iteration's statements is timed
+      _timing = true;
+      _stopwatch.start();
+
+      return true;
+    }
+
+    _report(_stopwatch.total());
+
+    return false;
+  }
+
+  void Measure::_next() noexcept
+  {
+    // first, for the same reason
+    _stopwatch.pause();
+    _timing = false;
+
+    const auto split = _chronometro_impl::_time<Unit::automatic, 0>{_stopwatch._duration_split};
+    _stopwatch._duration_split = {};
+
+    _allocations_split  = _chronometro_impl::_allocation_counters() - _allocations_start;
+    _allocations_total += _allocations_split;
+
+    if (_teardown)
+    {
+      _teardown(_iterations - _remaining);
+    }
+
+    if (_split_fmt)
+    {
+      _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
+      io::out() << _chronometro_impl::_split_fmt(split, _split_fmt, _iterations - _remaining, _allocations_split)
+        << '\n';
+    }
+
+    --_remaining;
+  }
+
+  void Measure::_stop() noexcept
+  {
+    _stopwatch.pause();
+
+    // broken out of mid-iteration
+    if (_timing)
+    {
+      _timing = false;
+
+      if (_teardown)
+      {
+        _teardown(_iterations - _remaining);
+      }
+    }
+
+    _remaining = 0;
+
+    _report(_stopwatch.total());
+  }
+
+  void Measure::_prepare_cache() noexcept
+  {
+    switch (_cache)
+    {
+      case Cache::warm:
+        return;
+      case Cache::evict:
+        _chronometro_impl::_evict_caches();
+        return;
+      case Cache::flush:
+        for (const auto& buffer : _flushed)
+        {
+          _chronometro_impl::_flush_cache_lines(buffer.first, buffer.second);
+        }
+        return;
+      default:
+        return;
+    }
+  }
+
+  void Measure::_report(const _chronometro_impl::_time<Unit::automatic, 0> duration_) noexcept
+  {
+#if defined(__linux__)
+    if (_cpu >= 0 or _cpu_node >= 0)
+    {
+      ::sched_setaffinity(0, sizeof(_affinity), &_affinity);
+    }
+
+    if (_memory_node >= 0)
+    {
+      _chronometro_impl::_set_mempolicy(_memory_policy);
+    }
+#endif
+
+    if _stz_impl_EXPECTED(_total_fmt)
+    {
+      _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
+      io::out() << _chronometro_impl::_total_fmt(duration_, _total_fmt, _iterations, _allocations_total) << '\n';
+
+      if (_audit)
+      {
+        io::out() << _environment << '\n';
+      }
+    }
+  }
+
+  Measure::Iteration::Iteration(const unsigned current_iteration_, Measure* const measurement_) noexcept
+    : value(current_iteration_)
+    , _measurement(measurement_)
+  {}
+
+  void Measure::Iteration::pause() noexcept
+  {
+    _measurement->pause();
+  }
+
+  void Measure::Iteration::start() noexcept
+  {
+    _measurement->start();
+  }
+
+  auto Measure::Iteration::avoid() noexcept -> Stopwatch::_guard
+  {
+    return _measurement->avoid();
+  }
+//*///------------------------------------------------------------------------------------------------------------------
+  Regulator::Regulator(const std::chrono::nanoseconds period_, const std::chrono::nanoseconds spin_) noexcept
+    : _period(period_ > std::chrono::nanoseconds::zero() ? period_ : std::chrono::nanoseconds(1))
+    , _spin(spin_)
+  {
+    reset();
+  }
+
+  bool Regulator::wait() noexcept
+  {
+    auto now = _chronometro_impl::_clock::now();
+
+    // deadlines are absolute, so time spent in the loop body does not accumulate as drift
+    _goal += _period;
+
+    const bool on_time = (now < _goal);
+
+    if _stz_impl_ABNORMAL(not on_time)
+    {
+      ++_overruns;
+
+      // skip the missed deadlines instead of bursting to catch up, keeping the original phase
+      _goal += ((now - _goal)/_period + 1)*_period;
+    }
+
+    if (_goal - now > _spin)
+    {
+      _chronometro_impl::_sleep_for(_goal - now - _spin);
+    }
+
+    while ((now = _chronometro_impl::_clock::now()) < _goal);
+
+    const auto lateness = std::chrono::nanoseconds(now - _goal);
+
+    _jitter += lateness;
+    _worst   = std::max(_worst, lateness);
+    _last    = now;
+
+    if (_ticks++ == 0)
+    {
+      _first = now;
+    }
+
+    return on_time;
+  }
+
+  void Regulator::reset() noexcept
+  {
+    _goal     = _chronometro_impl::_clock::now();
+    _first    = _goal;
+    _last     = _goal;
+    _ticks    = 0;
+    _overruns = 0;
+    _jitter   = {};
+    _worst    = {};
+  }
+
+  auto Regulator::statistics() const noexcept -> Statistics
+  {
+    const auto span = std::chrono::duration<double>(_last - _first).count();
+
+    return {
+      _ticks,
+      _overruns,
+      _ticks ? _jitter/static_cast<std::chrono::nanoseconds::rep>(_ticks) : std::chrono::nanoseconds{},
+      _worst,
+      (_ticks > 1 and span > 0) ? static_cast<double>(_ticks - 1)/span : 0.0
+    };
+  }
+//*///------------------------------------------------------------------------------------------------------------------
+  TimerWheel::TimerWheel(const std::chrono::nanoseconds tick_) noexcept
+    : _tick(tick_ > std::chrono::nanoseconds::zero() ? tick_ : std::chrono::nanoseconds(1))
+  {
+    for (auto& head : _heads)
+    {
+      head = _nil;
+    }
+  }
+
+  auto TimerWheel::after(const std::chrono::nanoseconds delay_, std::function<void()> callback_) -> Handle
+  {
+    const auto index = _allocate();
+    auto&      node  = _nodes[index];
+
+    node.callback = std::move(callback_);
+    node.expiry   = _current + _ticks(delay_);
+    node.period   = 0;
+    _link(index);
+
+    return {index, node.generation};
+  }
+
+  auto TimerWheel::every(const std::chrono::nanoseconds period_, std::function<void()> callback_) -> Handle
+  {
+    const auto handle = after(period_, std::move(callback_));
+    auto&      node   = _nodes[handle.index];
+
+    node.period = node.expiry - _current;
+
+    return handle;
+  }
+
+  bool TimerWheel::cancel(const Handle timer_) noexcept
+  {
+    if (timer_.index >= _nodes.size()) return false;
+
+    auto& node = _nodes[timer_.index];
+
+    if (not node.active or node.cancelled or node.generation != timer_.generation) return false;
+
+    if (node.list == _detached)
+    {
+      // currently firing, released once its callback returns
+      node.cancelled = true;
+    }
+    else
+    {
+      _unlink(timer_.index);
+      _release(timer_.index);
+    }
+
+    return true;
+  }
+
+  auto TimerWheel::poll() -> std::size_t
+  {
+    const auto target = static_cast<std::uint64_t>((_chronometro_impl::_clock::now() - _start)/_tick);
+
+    std::size_t fired = 0;
+    while (_current < target)
+    {
+      ++_current;
+
+      // cascade the slots of the coarser levels whose range has just been entered
+      for (unsigned level = 1; level < _levels; ++level)
+      {
+        const auto shift = level*_bits;
+
+        if (_current & ((std::uint64_t(1) << shift) - 1)) break;
+
+        auto& head = _heads[level*_slots + ((_current >> shift) & (_slots - 1))];
+
+        for (auto index = head; index != _nil;)
+        {
+          const auto next = _nodes[index].next;
+          _link(index);
+          index = next;
+        }
+
+        head = _nil;
+      }
+
+      if (_pending)
+      {
+        fired += _expire();
+      }
+    }
+
+    return fired;
+  }
+
+  auto TimerWheel::size() const noexcept -> std::size_t
+  {
+    return _pending;
+  }
+
+  auto TimerWheel::_ticks(const std::chrono::nanoseconds duration_) const noexcept -> std::uint64_t
+  {
+    if (duration_ <= std::chrono::nanoseconds::zero()) return 1;
+
+    return static_cast<std::uint64_t>((duration_ + _tick - std::chrono::nanoseconds(1))/_tick);
+  }
+
+  auto TimerWheel::_allocate() -> std::uint32_t
+  {
+    std::uint32_t index = _free;
+
+    if (index != _nil)
+    {
+      _free = _nodes[index].next;
+    }
+    else
+    {
+      index = static_cast<std::uint32_t>(_nodes.size());
+      _nodes.emplace_back();
+      _nodes[index].generation = 0;
+    }
+
+    _nodes[index].active    = true;
+    _nodes[index].cancelled = false;
+    ++_pending;
+
+    return index;
+  }
+
+  void TimerWheel::_release(const std::uint32_t index_) noexcept
+  {
+    auto& node = _nodes[index_];
+
+    node.callback = nullptr;
+    node.active   = false;
+    node.list     = _nil;
+    node.next     = _free;
+    ++node.generation;
+
+    _free = index_;
+    --_pending;
+  }
+
+  void TimerWheel::_link(const std::uint32_t index_) noexcept
+  {
+    auto& node = _nodes[index_];
+
+    // the level is chosen by how far ahead the expiry is, the slot by the expiry's own bits at that level
+    const auto delta = (node.expiry > _current) ? node.expiry - _current : 0;
+
+    unsigned level = 0;
+    while (level + 1 < _levels and delta >> ((level + 1)*_bits))
+    {
+      ++level;
+    }
+
+    if _stz_impl_ABNORMAL(delta >> (_levels*_bits))
+    {
+      node.expiry = _current + (std::uint64_t(1) << (_levels*_bits)) - 1;
+    }
+
+    const auto slot = (node.expiry > _current)
+      ? (node.expiry >> (level*_bits)) & (_slots - 1)
+      : (_current & (_slots - 1));
+
+    node.list     = static_cast<std::uint32_t>(level*_slots + slot);
+    node.previous = _nil;
+    node.next     = _heads[node.list];
+
+    if (node.next != _nil)
+    {
+      _nodes[node.next].previous = index_;
+    }
+
+    _heads[node.list] = index_;
+  }
+
+  void TimerWheel::_unlink(const std::uint32_t index_) noexcept
+  {
+    auto& node = _nodes[index_];
+
+    if (node.previous != _nil)
+    {
+      _nodes[node.previous].next = node.next;
+    }
+    else
+    {
+      _heads[node.list] = node.next;
+    }
+
+    if (node.next != _nil)
+    {
+      _nodes[node.next].previous = node.previous;
+    }
+
+    node.list = _detached;
+  }
+
+  auto TimerWheel::_expire() -> std::size_t
+  {
+    auto& head = _heads[_current & (_slots - 1)];
+
+    std::size_t fired = 0;
+    while (head != _nil)
+    {
+      const auto index = head;
+      _unlink(index);
+
+      // the callback may add timers, which can reallocate the nodes
+      auto callback = std::move(_nodes[index].callback);
+
+      const auto settle = [&]() noexcept -> void
+      {
+        auto& node = _nodes[index];
+
+        if (node.cancelled or node.period == 0)
+        {
+          _release(index);
+        }
+        else
+        {
+          node.callback = std::move(callback);
+          node.expiry  += node.period;
+          _link(index);
+        }
+      };
+
+      // a detached node is neither pending in a slot nor free, it must not outlive a throwing callback
+      try
+      {
+        callback();
+      }
+      catch(...)
+      {
+        settle();
+
+        // the next poll comes back to this tick, to fire the timers left in its slot
+        if (head != _nil) --_current;
+        throw;
+      }
+
+      settle();
+      ++fired;
+    }
+
+    return fired;
+  }
+//*///------------------------------------------------------------------------------------------------------------------
+  Budget::Budget(const std::chrono::nanoseconds budget_, const std::size_t capacity_)
+    : Budget(budget_, nullptr, capacity_)
+  {}
+
+  Budget::Budget(
+    const std::chrono::nanoseconds budget_, std::function<void(const Event&)> callback_, const std::size_t capacity_
+  )
+    : _budget(budget_)
+    , _capacity(capacity_)
+    , _callback(std::move(callback_))
+  {
+    _events.reserve(_capacity);
+  }
+
+  auto Budget::slowest() const -> std::vector<Event>
+  {
+    std::vector<Event> events;
+    {
+      _stz_impl_DECLARE_LOCK(_mtx);
+      events = _events;
+    }
+
+    std::sort(events.begin(), events.end(), [](const Event& lhs_, const Event& rhs_) -> bool
+    {
+      return lhs_.duration > rhs_.duration;
+    });
+
+    return events;
+  }
+
+  auto Budget::exceeded() const noexcept -> unsigned long long
+  {
+    _stz_impl_DECLARE_LOCK(_mtx);
+    return _exceeded;
+  }
+
+  void Budget::report() const noexcept
+  {
+    const auto events = slowest();
+
+    _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
+    io::out() << "budget: " << _chronometro_impl::_time_as_cstring(_chronometro_impl::_as_time(_budget));
+    io::out() << ", exceeded " << exceeded() << " times" << std::endl;
+
+    for (const auto& event : events)
+    {
+      const std::time_t seconds = std::chrono::system_clock::to_time_t(event.timestamp);
+      std::tm local = {};
+#   if defined(__unix__)
+      ::localtime_r(&seconds, &local);
+#   elif defined(_WIN32)
+      ::localtime_s(&local, &seconds);
+#   else
+      local = *std::localtime(&seconds);
+#   endif
+
+      char timestamp[32];
+      std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &local);
+
+      io::out() << "  " << timestamp << ": took "
+        << _chronometro_impl::_time_as_cstring(_chronometro_impl::_as_time(event.duration)) << std::endl;
+
+      for (unsigned k = 0; k < event.n_zones; ++k)
+      {
+        const auto& zone = event.zones[k];
+
+        io::out() << "    " << std::string(2*zone.depth, ' ') << zone.name << ": "
+          << _chronometro_impl::_time_as_cstring(_chronometro_impl::_as_time(zone.duration));
+        io::out() << " at +" << _chronometro_impl::_time_as_cstring(_chronometro_impl::_as_time(zone.offset));
+        io::out() << std::endl;
+      }
+    }
+  }
+
+  // called from Scope's destructor, so nothing may escape
+  void Budget::_capture(const Scope& scope_, const std::chrono::nanoseconds duration_) noexcept
+  {
+    Event event;
+    event.duration  = duration_;
+    event.timestamp = std::chrono::system_clock::now();
+    event.n_zones   = (scope_._n_zones < max_zones) ? scope_._n_zones : max_zones;
+    std::copy(scope_._zones, scope_._zones + event.n_zones, event.zones);
+
+    {
+      _stz_impl_DECLARE_LOCK(_mtx);
+      ++_exceeded;
+
+      // reserved up front, so this never allocates
+      if (_events.size() < _capacity)
+      {
+        _events.push_back(event);
+      }
+      else if (_capacity)
+      {
+        // the ring is small and only touched on the slow path, a linear scan for the fastest entry suffices
+        std::size_t fastest = 0;
+        for (std::size_t k = 1; k < _events.size(); ++k)
+        {
+          if (_events[k].duration < _events[fastest].duration) fastest = k;
+        }
+
+        if (_events[fastest].duration < duration_)
+        {
+          _events[fastest] = event;
+        }
+      }
+    }
+
+    if (_callback)
+    {
+      try
+      {
+        _callback(event);
+      }
+      catch (...)
+      {
+        _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
+        io::wrn() << "stz: Budget: the callback threw, the exception is dropped" << std::endl;
+      }
+    }
+  }
+
+  Budget::Scope::Scope(Budget& budget_) noexcept
+    : _owner(&budget_)
+  {}
+
+  auto Budget::Scope::zone(const char* const name_) noexcept -> _zone
+  {
+    return _zone(this, name_);
+  }
+
+  Budget::Scope::~Scope() noexcept
+  {
+    const auto duration = std::chrono::nanoseconds(_chronometro_impl::_clock::now() - _start);
+
+    if _stz_impl_ABNORMAL(duration > _owner->_budget)
+    {
+      _owner->_capture(*this, duration);
+    }
+  }
+//*///------------------------------------------------------------------------------------------------------------------
+  Accumulator::Accumulator() noexcept
+  {
+    reset();
+  }
+
+  void Accumulator::add(const std::chrono::nanoseconds duration_, const unsigned long long count_) noexcept
+  {
+    auto& shard = _shards[_shard_index()];
+    const std::int64_t nanoseconds = duration_.count();
+
+    // seqlock tolerant of several writers: readers retry until no write began after the last one they saw end
+    shard.begun.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    shard.count.fetch_add(count_, std::memory_order_relaxed);
+    shard.sum.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+    auto min = shard.min.load(std::memory_order_relaxed);
+    while (nanoseconds < min and not shard.min.compare_exchange_weak(min, nanoseconds, std::memory_order_relaxed));
+
+    auto max = shard.max.load(std::memory_order_relaxed);
+    while (nanoseconds > max and not shard.max.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed));
+
+    shard.ended.fetch_add(1, std::memory_order_release);
+  }
+
+  template<Unit unit, unsigned n_decimals>
+  void Accumulator::add(
+    const _chronometro_impl::_time<unit, n_decimals> duration_, const unsigned long long count_
+  ) noexcept
+  {
+    add(duration_.nanoseconds, count_);
+  }
+
+  auto Accumulator::snapshot() const noexcept -> Snapshot
+  {
+    Snapshot total = {0, {}, std::chrono::nanoseconds::max(), std::chrono::nanoseconds::min()};
+
+    for (const auto& shard : _shards)
+    {
+      std::uint64_t count;
+      std::int64_t  sum, min, max;
+
+      for (unsigned attempt = 0;; ++attempt)
+      {
+        const auto ended = shard.ended.load(std::memory_order_acquire);
+
+        count = shard.count.load(std::memory_order_relaxed);
+        sum   = shard.sum.load(std::memory_order_relaxed);
+        min   = shard.min.load(std::memory_order_relaxed);
+        max   = shard.max.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if _stz_impl_EXPECTED(shard.begun.load(std::memory_order_relaxed) == ended) break;
+
+        if (attempt > 64)
+        {
+          _chronometro_impl::_yield();
+        }
+      }
+
+      if (count == 0) continue;
+
+      total.count += count;
+      total.sum   += std::chrono::nanoseconds(sum);
+      total.min    = std::min(total.min, std::chrono::nanoseconds(min));
+      total.max    = std::max(total.max, std::chrono::nanoseconds(max));
+    }
+
+    if (total.count == 0)
+    {
+      total.min = {};
+      total.max = {};
+    }
+
+    return total;
+  }
+
+  void Accumulator::reset() noexcept
+  {
+    for (auto& shard : _shards)
+    {
+      shard.begun.store(0, std::memory_order_relaxed);
+      shard.ended.store(0, std::memory_order_relaxed);
+      shard.count.store(0, std::memory_order_relaxed);
+      shard.sum.store(0, std::memory_order_relaxed);
+      shard.min.store(std::numeric_limits<std::int64_t>::max(), std::memory_order_relaxed);
+      shard.max.store(std::numeric_limits<std::int64_t>::min(), std::memory_order_relaxed);
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  auto Accumulator::_shard_index() noexcept -> unsigned
+  {
+    static std::atomic<unsigned> threads(0);
+    static _stz_impl_THREADLOCAL const unsigned index = threads.fetch_add(1, std::memory_order_relaxed) % _n_shards;
+
+    return index;
+  }
+//*///------------------------------------------------------------------------------------------------------------------
+  LiveMetric::LiveMetric(const char* const name_)
+    : _name(name_)
+    , _slots(new _slot[_n_slots])
+  {
+    for (unsigned k = 0; k < _n_slots; ++k)
+    {
+      _slots[k].second = -1;
+      _slots[k].histogram.clear();
+    }
+  }
+
+  void LiveMetric::record(const std::chrono::nanoseconds duration_) noexcept
+  {
+    const auto second = std::chrono::duration_cast<std::chrono::seconds>(
+      _chronometro_impl::_clock::now() - _start).count();
+
+    auto& slot = _slots[static_cast<std::size_t>(second) % _n_slots];
+
+    _stz_impl_DECLARE_LOCK(_mtx);
+
+    // rotate the slot out once its second is a full revolution old
+    if _stz_impl_ABNORMAL(slot.second != second)
+    {
+      slot.second = second;
+      slot.histogram.clear();
+    }
+
+    slot.histogram.record(duration_.count());
+  }
+
+  template<Unit unit, unsigned n_decimals>
+  void LiveMetric::record(const _chronometro_impl::_time<unit, n_decimals> duration_) noexcept
+  {
+    record(duration_.nanoseconds);
+  }
+
+  auto LiveMetric::window(const std::chrono::seconds span_) const noexcept -> Window
+  {
+    const auto elapsed = std::chrono::duration<double>(_chronometro_impl::_clock::now() - _start).count();
+    const auto current = static_cast<std::int64_t>(elapsed);
+    const auto span    = std::min<std::int64_t>(std::max<std::int64_t>(span_.count(), 1), _n_slots - 1);
+
+    // windows end at the last complete second, unless not even one has elapsed yet
+    const auto   last    = (current > 0) ? current - 1 : 0;
+    const double covered = (current > 0) ? static_cast<double>(std::min(span, current)) : elapsed;
+
+    _chronometro_impl::_histogram merged;
+    merged.clear();
+
+    {
+      _stz_impl_DECLARE_LOCK(_mtx);
+
+      for (unsigned k = 0; k < _n_slots; ++k)
+      {
+        const auto age = last - _slots[k].second;
+        if (age >= 0 and age < span)
+        {
+          merged.merge(_slots[k].histogram);
+        }
+      }
+    }
+
+    return {
+      std::chrono::seconds(span),
+      merged.count,
+      covered > 0 ? static_cast<double>(merged.count)/covered : 0.0,
+      std::chrono::nanoseconds(merged.percentile(0.50)),
+      std::chrono::nanoseconds(merged.percentile(0.99)),
+      std::chrono::nanoseconds(merged.max)
+    };
+  }
+
+  auto LiveMetric::snapshot() const noexcept -> Snapshot
+  {
+    return {
+      _name, {window(std::chrono::seconds(1)), window(std::chrono::seconds(10)), window(std::chrono::seconds(60))}
+    };
+  }
+
+#if defined(_stz_impl_THREADSAFE)
+  Reporter::Reporter(
+    const std::chrono::nanoseconds interval_, std::function<void(const LiveMetric::Snapshot&)> publish_
+  )
+    : _interval(interval_ > std::chrono::nanoseconds::zero() ? interval_ : std::chrono::seconds(1))
+    , _publish(std::move(publish_))
+    , _thread(&Reporter::_run, this)
+  {}
+
+  void Reporter::add(const LiveMetric& metric_)
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _metrics.push_back(&metric_);
+  }
+
+  Reporter::~Reporter() noexcept
+  {
+    {
+      std::lock_guard<std::mutex> lock(_mtx);
+      _stop = true;
+    }
+
+    _wake.notify_all();
+    _thread.join();
+  }
+
+  void Reporter::_run()
+  {
+    // deadlines are absolute so that the publishing interval does not drift
+    auto goal = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(_mtx);
+    while (true)
+    {
+      goal += _interval;
+
+      if (_wake.wait_until(lock, goal, [this]{ return _stop; })) return;
+
+      const auto metrics = _metrics;
+      lock.unlock();
+
+      for (const auto metric : metrics)
+      {
+        const auto snapshot = metric->snapshot();
+
+        if (_publish)
+        {
+          _publish(snapshot);
+          continue;
+        }
+
+        std::string line = snapshot.name;
+        for (const auto& window : snapshot.windows)
+        {
+          char text[64];
+          std::sprintf(text, " | %llds: %llu (%.1f/s)",
+            static_cast<long long>(window.span.count()), window.count, window.rate);
+          line += text;
+          line += " p50 ";
+          line += _chronometro_impl::_time_as_cstring(_chronometro_impl::_as_time(window.p50));
+          line += " p99 ";
+          line += _chronometro_impl::_time_as_cstring(_chronometro_impl::_as_time(window.p99));
+          line += " max ";
+          line += _chronometro_impl::_time_as_cstring(_chronometro_impl::_as_time(window.max));
+        }
+
+        _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
+        io::out() << line << std::endl;
+      }
+
+      lock.lock();
+    }
+  }
+#endif
+//*///------------------------------------------------------------------------------------------------------------------
+  SharedMetrics::Metric::Metric(_chronometro_impl::_shared_metric* const metric_) noexcept
+    : _metric(metric_)
+  {}
+
+  void SharedMetrics::Metric::record(const std::chrono::nanoseconds duration_) noexcept
+  {
+    if _stz_impl_ABNORMAL(_metric == nullptr) return;
+
+    auto& metric = *_metric;
+    const std::int64_t nanoseconds = duration_.count();
+
+    // writers take the sequence odd in turn, tagged with their pid; readers retry while it is odd or has moved
+    auto sequence = metric.sequence.load(std::memory_order_relaxed);
+    auto locked   = sequence;
+    for (unsigned attempt = 0;; ++attempt)
+    {
+      if ((sequence & 1) == 0)
+      {
+        locked = (sequence | 1) | _chronometro_impl::_shared_pid();
+        if (metric.sequence.compare_exchange_weak(sequence, locked,
+          std::memory_order_acquire, std::memory_order_relaxed)) break;
+
+        continue;
+      }
+
+      // a writer that died mid-update would hold the metric forever, take over and leave its record partial
+      if (attempt % 64 == 63)
+      {
+        if (_chronometro_impl::_shared_owner_dead(sequence))
+        {
+          metric.sequence.compare_exchange_strong(sequence, _chronometro_impl::_shared_next(sequence),
+            std::memory_order_relaxed);
+        }
+
+        _chronometro_impl::_yield();
+      }
+
+      sequence = metric.sequence.load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    metric.count.store(metric.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    metric.sum.store(metric.sum.load(std::memory_order_relaxed) + nanoseconds, std::memory_order_relaxed);
+
+    if (nanoseconds < metric.min.load(std::memory_order_relaxed))
+    {
+      metric.min.store(nanoseconds, std::memory_order_relaxed);
+    }
+
+    if (nanoseconds > metric.max.load(std::memory_order_relaxed))
+    {
+      metric.max.store(nanoseconds, std::memory_order_relaxed);
+    }
+
+    auto& bucket = metric.buckets[_chronometro_impl::_histogram::bucket(nanoseconds)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    metric.sequence.store(_chronometro_impl::_shared_next(locked), std::memory_order_release);
+  }
+
+  template<Unit unit, unsigned n_decimals>
+  void SharedMetrics::Metric::record(const _chronometro_impl::_time<unit, n_decimals> duration_) noexcept
+  {
+    record(duration_.nanoseconds);
+  }
+
+  void SharedMetrics::Metric::count(const unsigned long long n_) noexcept
+  {
+    if _stz_impl_EXPECTED(_metric != nullptr)
+    {
+      _metric->counter.fetch_add(n_, std::memory_order_relaxed);
+    }
+  }
+
+  SharedMetrics::SharedMetrics(const char* const path_, const unsigned capacity_) noexcept
+  {
+#if defined(__unix__)
+    const std::size_t size = sizeof(_chronometro_impl::_shared_header)
+      + std::size_t(capacity_)*sizeof(_chronometro_impl::_shared_metric);
+
+    // locked until initialized, so that of processes opening the segment at once only the first initializes it;
+    // never truncated nor shrunk, readers that mapped the file would fault on the pages it lost
+    struct stat status;
+    const int file = ::open(path_, O_RDWR | O_CREAT, 0644);
+    if (file < 0 or ::flock(file, LOCK_EX) != 0 or ::fstat(file, &status) != 0
+     or (std::size_t(status.st_size) < size and ::ftruncate(file, static_cast<off_t>(size)) != 0))
+    {
+      if (file >= 0) ::close(file);
+      _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
+      io::wrn() << "stz: SharedMetrics: could not create \"" << path_ << "\", metrics are discarded" << std::endl;
+      return;
+    }
+
+    void* const map = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+
+    if (map == MAP_FAILED)
+    {
+      ::close(file);
+      _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
+      io::wrn() << "stz: SharedMetrics: could not map \"" << path_ << "\", metrics are discarded" << std::endl;
+      return;
+    }
+
+    _map  = map;
+    _size = size;
+
+    const auto& existing = *static_cast<const _chronometro_impl::_shared_header*>(_map);
+    const bool ours = std::size_t(status.st_size) >= sizeof(existing)
+      and std::strncmp(existing.magic, "stzchz", 7) == 0;
+
+    // metrics other processes registered stay theirs, later ones take the next slots
+    if (ours and existing.version == _chronometro_impl::_shared_version and existing.capacity == capacity_
+      and existing.metric_size == sizeof(_chronometro_impl::_shared_metric))
+    {
+      // unlocked explicitly, the mapping keeps the locked file open past close
+      ::flock(file, LOCK_UN);
+      ::close(file);
+      return;
+    }
+
+    if (ours)
+    {
+      _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
+      io::wrn() << "stz: SharedMetrics: \"" << path_ << "\" has another layout or capacity, it is reset" << std::endl;
+    }
+
+    // reset in place: readers first see no metrics, then unregistered ones reading as sequence 0
+    auto& header = (status.st_size == 0)
+      ? *new(_map) _chronometro_impl::_shared_header()
+      : *static_cast<_chronometro_impl::_shared_header*>(_map);
+    header.n_metrics.store(0, std::memory_order_release);
+    std::memset(static_cast<void*>(_metrics(_map)), 0, size - sizeof(header));
+
+    std::memcpy(header.magic, "stzchz", 7);
+    header.version     = _chronometro_impl::_shared_version;
+    header.capacity    = capacity_;
+    header.metric_size = sizeof(_chronometro_impl::_shared_metric);
+    header.created     = static_cast<std::int64_t>(std::time(nullptr));
+    header.pid         = static_cast<std::int64_t>(::getpid());
+    header.n_metrics.store(0, std::memory_order_release);
+
+    ::flock(file, LOCK_UN);
+    ::close(file);
+#else
+    _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
+    io::wrn() << "stz: SharedMetrics: shared memory is not supported on this platform" << std::endl;
+#endif
+  }
+
+  SharedMetrics::~SharedMetrics() noexcept
+  {
+#if defined(__unix__)
+    if (_map) ::munmap(_map, _size);
+#endif
+  }
+
+  auto SharedMetrics::metric(const char* const name_) noexcept -> Metric
+  {
+    if _stz_impl_ABNORMAL(_map == nullptr) return Metric(nullptr);
+
+    auto& header = _header();
+
+    // a restarted or second process records into its metrics again, rather than filling the segment with copies
+    const auto n_metrics = std::min(header.n_metrics.load(std::memory_order_acquire), header.capacity);
+    for (std::uint32_t k = 0; k < n_metrics; ++k)
+    {
+      auto& metric = _metrics(_map)[k];
+      if (metric.sequence.load(std::memory_order_acquire) != 0
+        and std::strncmp(metric.name, name_, sizeof(metric.name) - 1) == 0) return Metric(&metric);
+    }
+
+    const auto index = header.n_metrics.fetch_add(1, std::memory_order_relaxed);
+
+    if _stz_impl_ABNORMAL(index >= header.capacity)
+    {
+      _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
+      io::wrn() << "stz: SharedMetrics: capacity exceeded, \"" << name_ << "\" is discarded" << std::endl;
+      return Metric(nullptr);
+    }
+
+    auto& metric = _metrics(_map)[index];
+    std::strncpy(metric.name, name_, sizeof(metric.name) - 1);
+    metric.min.store(std::numeric_limits<std::int64_t>::max(), std::memory_order_relaxed);
+
+    // readers skip the metric until its sequence becomes even and non-zero
+    metric.sequence.store(2, std::memory_order_release);
+
+    return Metric(&metric);
+  }
+
+  auto SharedMetrics::read(const char* const path_) -> std::vector<Snapshot>
+  {
+    std::vector<Snapshot> snapshots;
+
+#if defined(__unix__)
+    const int file = ::open(path_, O_RDONLY);
+    if (file < 0) return snapshots;
+
+    struct stat status;
+    void* map = MAP_FAILED;
+    if (::fstat(file, &status) == 0 and std::size_t(status.st_size) >= sizeof(_chronometro_impl::_shared_header))
+    {
+      map = ::mmap(nullptr, std::size_t(status.st_size), PROT_READ, MAP_SHARED, file, 0);
+    }
+    ::close(file);
+
+    if (map == MAP_FAILED) return snapshots;
+
+    const auto& header = *static_cast<const _chronometro_impl::_shared_header*>(map);
+    const std::size_t size = std::size_t(status.st_size);
+
+    if (std::strncmp(header.magic, "stzchz", 7) != 0
+      or header.version     != _chronometro_impl::_shared_version
+      or header.metric_size != sizeof(_chronometro_impl::_shared_metric)
+      or size < sizeof(header) + std::size_t(header.capacity)*sizeof(_chronometro_impl::_shared_metric))
+    {
+      ::munmap(map, size);
+      _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
+      io::wrn() << "stz: SharedMetrics: \"" << path_ << "\" is not a compatible segment" << std::endl;
+      return snapshots;
+    }
+
+    const auto n_metrics = std::min(header.n_metrics.load(std::memory_order_acquire), header.capacity);
+    const auto metrics   = _metrics(map);
+
+    _chronometro_impl::_histogram histogram;
+    for (std::uint32_t k = 0; k < n_metrics; ++k)
+    {
+      const auto& metric = metrics[k];
+
+      Snapshot snapshot;
+      std::int64_t min;
+      bool registered = true;
+      bool torn       = false;
+
+      for (unsigned attempt = 0;; ++attempt)
+      {
+        const auto sequence = metric.sequence.load(std::memory_order_acquire);
+
+        if (sequence == 0)
+        {
+          registered = false;
+          break;
+        }
+
+        // read as is when writers keep it busy beyond patience, or when the one holding it is dead
+        torn = attempt >= _chronometro_impl::_shared_patience
+          or ((sequence & 1) and attempt % 64 == 63 and _chronometro_impl::_shared_owner_dead(sequence));
+
+        if _stz_impl_EXPECTED((sequence & 1) == 0 or torn)
+        {
+          std::memcpy(snapshot.name, metric.name, sizeof(snapshot.name));
+          histogram.count = metric.count.load(std::memory_order_relaxed);
+          histogram.sum   = metric.sum.load(std::memory_order_relaxed);
+          histogram.max   = metric.max.load(std::memory_order_relaxed);
+          min             = metric.min.load(std::memory_order_relaxed);
+          for (unsigned b = 0; b < histogram.n_buckets; ++b)
+          {
+            histogram.buckets[b] = metric.buckets[b].load(std::memory_order_relaxed);
+          }
+
+          std::atomic_thread_fence(std::memory_order_acquire);
+
+          if _stz_impl_EXPECTED(torn or metric.sequence.load(std::memory_order_relaxed) == sequence) break;
+        }
+
+        if (attempt > 64)
+        {
+          _chronometro_impl::_yield();
+        }
+      }
+
+      if (not registered) continue;
+
+      snapshot.name[sizeof(snapshot.name) - 1] = '\0';
+      snapshot.counter = metric.counter.load(std::memory_order_relaxed);
+      snapshot.count   = histogram.count;
+      snapshot.sum     = std::chrono::nanoseconds(histogram.sum);
+      snapshot.min     = std::chrono::nanoseconds(histogram.count ? min : 0);
+      snapshot.max     = std::chrono::nanoseconds(histogram.max);
+      snapshot.p50     = std::chrono::nanoseconds(histogram.percentile(0.50));
+      snapshot.p99     = std::chrono::nanoseconds(histogram.percentile(0.99));
+      snapshot.torn    = torn;
+      snapshots.push_back(snapshot);
+    }
+
+    ::munmap(map, size);
+#else
+    (void)path_;
+#endif
+
+    return snapshots;
+  }
+
+  auto SharedMetrics::_header() const noexcept -> _chronometro_impl::_shared_header&
+  {
+    return *static_cast<_chronometro_impl::_shared_header*>(_map);
+  }
+
+  auto SharedMetrics::_metrics(void* const map_) noexcept -> _chronometro_impl::_shared_metric*
+  {
+    return reinterpret_cast<_chronometro_impl::_shared_metric*>(
+      static_cast<char*>(map_) + sizeof(_chronometro_impl::_shared_header));
+  }
+//*///------------------------------------------------------------------------------------------------------------------
+#if defined(_stz_impl_THREADSAFE)
+  TimedMutex::TimedMutex(const char* const name_) noexcept
+    : _name(name_)
+  {
+    _wait.clear();
+    _hold.clear();
+  }
+
+  void TimedMutex::lock() noexcept
+  {
+    const auto requested = _chronometro_impl::_clock::now();
+
+    // the statistics are guarded by the mutex itself, so contention is recorded once it is acquired
+    const bool contended = not _mtx.try_lock();
+    if (contended)
+    {
+      _mtx.lock();
+    }
+
+    _acquired     = _chronometro_impl::_clock::now();
+    _waited       = _acquired - requested;
+    _contentions += contended;
+  }
+
+  auto TimedMutex::try_lock() noexcept -> bool
+  {
+    if (not _mtx.try_lock()) return false;
+
+    _acquired = _chronometro_impl::_clock::now();
+    _waited   = {};
+
+    return true;
+  }
+
+  void TimedMutex::unlock() noexcept
+  {
+    const auto released = _chronometro_impl::_clock::now();
+
+    _wait.record(_waited.count());
+    _hold.record(std::chrono::duration_cast<std::chrono::nanoseconds>(released - _acquired).count());
+
+    _mtx.unlock();
+  }
+
+  auto TimedMutex::statistics() const noexcept -> Statistics
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+
+    return {
+      _name,
+      _wait.count,
+      _contentions,
+      {
+        std::chrono::nanoseconds(_wait.sum),
+        std::chrono::nanoseconds(_wait.percentile(0.50)),
+        std::chrono::nanoseconds(_wait.percentile(0.99)),
+        std::chrono::nanoseconds(_wait.max)
+      },
+      {
+        std::chrono::nanoseconds(_hold.sum),
+        std::chrono::nanoseconds(_hold.percentile(0.50)),
+        std::chrono::nanoseconds(_hold.percentile(0.99)),
+        std::chrono::nanoseconds(_hold.max)
+      }
+    };
+  }
+
+  void TimedMutex::report() const noexcept
+  {
+    const auto statistics = this->statistics();
+
+    const double contended = statistics.acquisitions
+      ? 100.0*static_cast<double>(statistics.contentions)/static_cast<double>(statistics.acquisitions) : 0.0;
+
+    _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
+    io::out() << statistics.name << ": " << statistics.acquisitions << " acquisitions, "
+      << statistics.contentions << " contended (" << contended << "%)" << std::endl;
+
+    const std::pair<const char*, const Times*> rows[] = {{"wait", &statistics.wait}, {"hold", &statistics.hold}};
+    for (const auto& row : rows)
+    {
+      io::out() << "  " << row.first
+        << ": total " << _chronometro_impl::_time_as_cstring(_chronometro_impl::_as_time(row.second->total));
+      io::out() << ", p50 " << _chronometro_impl::_time_as_cstring(_chronometro_impl::_as_time(row.second->p50));
+      io::out() << ", p99 " << _chronometro_impl::_time_as_cstring(_chronometro_impl::_as_time(row.second->p99));
+      io::out() << ", max " << _chronometro_impl::_time_as_cstring(_chronometro_impl::_as_time(row.second->max));
+      io::out() << std::endl;
+    }
+  }
+#endif
+//*///------------------------------------------------------------------------------------------------------------------
+  NumaBuffer::NumaBuffer(const std::size_t size_, const unsigned node_) noexcept
+  {
+#if defined(__unix__)
+    void* const data = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED)
+#else
+    void* const data = std::malloc(size_);
+    if (data == nullptr)
+#endif
+    {
+      _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
+      io::wrn() << "stz: NumaBuffer: could not allocate " << size_ << " bytes" << std::endl;
+      return;
+    }
+
+    _data = static_cast<char*>(data);
+    _size = size_;
+
+#if defined(__linux__)
+    _bound = _chronometro_impl::_mbind(_data, _size, node_);
+#endif
+
+    // bound() tells every buffer apart, warning once suffices when the platform or the node does not allow binding
+    static std::atomic<bool> warned(false);
+    if (not _bound and not warned.exchange(true, std::memory_order_relaxed))
+    {
+      _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
+      io::wrn() << "stz: NumaBuffer: could not bind " << size_ << " bytes to node " << node_
+        << ", they and those of later failures are placed by the default policy" << std::endl;
+    }
+
+    // fault every page in now, on the bound node, rather than during a measurement
+    std::memset(_data, 0, _size);
+  }
+
+  NumaBuffer::~NumaBuffer() noexcept
+  {
+#if defined(__unix__)
+    if (_data) ::munmap(_data, _size);
+#else
+    std::free(_data);
+#endif
+  }
+
+  auto NumaBuffer::data() const noexcept -> char*
+  {
+    return _data;
+  }
+
+  auto NumaBuffer::size() const noexcept -> std::size_t
+  {
+    return _size;
+  }
+
+  auto NumaBuffer::bound() const noexcept -> bool
+  {
+    return _bound;
+  }
+
+  auto numa_nodes() noexcept -> unsigned
+  {
+#if defined(__linux__)
+    cpu_set_t nodes;
+    const unsigned count = _chronometro_impl::_online_nodes(nodes);
+
+    return count ? count : 1;
+#else
+    return 1;
+#endif
+  }
+
+  auto pin_to_node(const unsigned node_) noexcept -> bool
+  {
+#if defined(__linux__)
+    cpu_set_t cpus;
+
+    return _chronometro_impl::_node_cpus(node_, cpus) != 0 and ::sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+#else
+    (void)node_;
+    return false;
+#endif
+  }
+
+  auto numa_sweep(const std::size_t size_, const unsigned rounds_) -> std::vector<NumaPlacement>
+  {
+    std::vector<unsigned> nodes;
+
+#if defined(__linux__)
+    cpu_set_t online;
+    _chronometro_impl::_online_nodes(online);
+
+    for (int node = 0; node < CPU_SETSIZE; ++node)
+    {
+      if (CPU_ISSET(node, &online)) nodes.push_back(static_cast<unsigned>(node));
+    }
+
+    cpu_set_t  affinity;
+    const bool restore = ::sched_getaffinity(0, sizeof(affinity), &affinity) == 0;
+#endif
+
+    // NUMA is not supported, node 0 is the whole host
+    if (nodes.empty()) nodes.push_back(0);
+
+    std::vector<NumaPlacement> placements;
+
+    for (const auto cpu_node : nodes)
+    {
+      // memory-only nodes have no cpus to measure from, a single node is measured unpinned if need be
+      if (not pin_to_node(cpu_node) and nodes.size() > 1) continue;
+
+      const std::size_t first = placements.size();
+      std::size_t       local = first;
+      bool              found = false;
+
+      for (const auto memory_node : nodes)
+      {
+        NumaBuffer buffer(size_, memory_node);
+        if (buffer.data() == nullptr) continue;
+
+        NumaPlacement placement = {};
+        placement.cpu_node    = cpu_node;
+        placement.memory_node = memory_node;
+        placement.bound       = buffer.bound();
+        placement.latency     = _chronometro_impl::_chase_latency(buffer.data(), buffer.size(), rounds_);
+        placement.bandwidth   = _chronometro_impl::_read_bandwidth(buffer.data(), buffer.size(), rounds_);
+
+        if (memory_node == cpu_node)
+        {
+          local = placements.size();
+          found = true;
+        }
+
+        placements.push_back(placement);
+      }
 
-      _previous = _chronometro_impl::_clock::now();
+      // penalties are relative to the fastest memory when the cpu node has none of its own
+      for (std::size_t k = first; not found and k < placements.size(); ++k)
+      {
+        if (placements[k].latency < placements[local].latency) local = k;
+      }
+
+      for (std::size_t k = first; k < placements.size(); ++k)
+      {
+        placements[k].latency_penalty   = placements[local].latency > 0
+          ? placements[k].latency/placements[local].latency : 1;
+        placements[k].bandwidth_penalty = placements[k].bandwidth > 0
+          ? placements[local].bandwidth/placements[k].bandwidth : 1;
+      }
     }
 
-    return _chronometro_impl::_time<Unit::automatic, 0>{split_duration};
+#if defined(__linux__)
+    if (restore) ::sched_setaffinity(0, sizeof(affinity), &affinity);
+#endif
+
+    return placements;
   }
 
-  _stz_impl_NODISCARD_REASON("total: not using the return value makes no sens.")
-  auto Stopwatch::total() noexcept -> _chronometro_impl::_time<Unit::automatic, 0>
+  std::ostream& operator<<(std::ostream& ostream_, const NumaPlacement& placement_) noexcept
   {
-    const auto now = _chronometro_impl::_clock::now();
+    char text[128];
+    std::sprintf(text, "latency %.1f ns (x%.2f), bandwidth %.1f GB/s (x%.2f)", placement_.latency,
+      placement_.latency_penalty, placement_.bandwidth, placement_.bandwidth_penalty);
 
-    auto total_duration = _duration_total;
+    ostream_ << "cpu node " << placement_.cpu_node << ", memory node " << placement_.memory_node << ": " << text;
 
-    if _stz_impl_EXPECTED(not _paused)
+    if (not placement_.bound)
     {
-      total_duration += now - _previous;
-
-      _duration_split = {};
-      _duration_total = {};
+      ostream_ << ", not bound";
     }
 
-    return _chronometro_impl::_time<Unit::automatic, 0>{total_duration};
+    return ostream_;
   }
-
-  void Stopwatch::reset() noexcept
+//*///------------------------------------------------------------------------------------------------------------------
+  auto characterize_clocks() -> std::vector<ClockCharacteristics>
   {
-    _duration_total = {};
-    _duration_split = {};
-
-    if (_paused) return;
+#if defined(_stz_impl_THREADSAFE)
+    std::lock_guard<std::mutex> lock(_chronometro_impl::_clock_mtx());
+#endif
+    return _chronometro_impl::_characterize_clocks();
+  }
 
-    _previous = _chronometro_impl::_clock::now();
+  auto select_clock(const std::chrono::nanoseconds precision_) -> ClockCharacteristics
+  {
+    return _chronometro_impl::_select_clock(precision_, true);
   }
 
-  void Stopwatch::pause() noexcept
+  std::ostream& operator<<(std::ostream& ostream_, const ClockCharacteristics& characteristics_) noexcept
   {
-    const auto now = _chronometro_impl::_clock::now();
+    ostream_ << characteristics_.name << ": ";
 
-    if _stz_impl_ABNORMAL(_paused) return;
+    if (not characteristics_.available)
+    {
+      return ostream_ << "unavailable";
+    }
 
-    _paused = true;
+    char text[32];
+    std::sprintf(text, "%.1f", characteristics_.read_cost);
 
-    _duration_total += now - _previous;
-    _duration_split += now - _previous;
+    ostream_ << "resolution " << characteristics_.resolution.count() << " ns, read cost " << text << " ns"
+      << (characteristics_.monotonic  ? ", monotonic"  : ", not monotonic")
+      << (characteristics_.consistent ? ", consistent" : ", inconsistent across cpus");
+
+    return ostream_;
   }
 
-  void Stopwatch::start() noexcept
+  auto RuntimeClock::now() noexcept -> time_point
   {
-    if _stz_impl_EXPECTED(_paused)
-    {
-      _paused = false;
-
-      _previous = _chronometro_impl::_clock::now();
-    }
+    // pairs with the release in _select_clock, so that sources read the state set before dispatching to them
+    return time_point(duration(_chronometro_impl::_runtime_source().load(std::memory_order_acquire)()));
   }
 
-  auto Stopwatch::avoid() noexcept -> _guard
+  void RuntimeClock::init() noexcept
   {
-    return _guard(this);
+    _chronometro_impl::_select_clock(std::chrono::nanoseconds(100), false);
   }
 //*///------------------------------------------------------------------------------------------------------------------
-  Measure::Measure(const unsigned iterations_) noexcept
-    : _iterations(iterations_)
-    , _total_fmt((_iterations > 1) ? "total elapsed time: %ms [avg = %Dus]" : "total elapsed time: %ms")
-  {}
-
-  Measure::Measure(const unsigned iterations_, const char* const iteration_format_) noexcept
-    : _iterations(iterations_)
-    , _split_fmt(iteration_format_ && *iteration_format_ ? iteration_format_ : nullptr)
-    , _total_fmt((_iterations > 1) ? "total elapsed time: %ms [avg = %Dus]" : "total elapsed time: %ms")
-  {}
-
-  Measure::Measure(
-    const unsigned iterations_, const char* const iteration_format_, const char* const total_format_
-  ) noexcept
-    : _iterations(iterations_)
-    , _split_fmt(iteration_format_ && *iteration_format_ ? iteration_format_ : nullptr)
-    , _total_fmt(total_format_     && *total_format_     ? total_format_     : nullptr)
-  {}
-
-  Measure::Measure(const char* const total_format_) noexcept
-    : _total_fmt(total_format_ && *total_format_ ? total_format_ : nullptr)
-  {}
-
-  Measure::Measure(const char* const total_format_, const unsigned iterations_) noexcept
-    : _iterations(iterations_)
-    , _total_fmt(total_format_ && *total_format_ ? total_format_ : nullptr)
+#if defined(_stz_impl_COROUTINES)
+  Span::Span() noexcept
   {}
 
-  void Measure::pause() noexcept
+  template<typename A>
+  auto Span::operator()(A&& awaitable_) -> _chronometro_impl::_timed_awaiter<A&&>
   {
-    _stopwatch.pause();
+    return {*this, static_cast<A&&>(awaitable_)};
   }
 
-  void Measure::start() noexcept
+  auto Span::times() const noexcept -> Times
   {
-    _stopwatch.start();
+    const auto now = _chronometro_impl::_clock::now();
+
+    // an ongoing suspension counts as suspended so far
+    auto suspended = _suspended;
+    if (_is_suspended)
+    {
+      suspended += std::chrono::duration_cast<std::chrono::nanoseconds>(now - _suspended_at);
+    }
+
+    return {std::chrono::duration_cast<std::chrono::nanoseconds>(now - _start) - suspended, suspended, _suspensions};
   }
 
-  auto Measure::avoid() noexcept -> Stopwatch::_guard
+  void Span::_suspend() noexcept
   {
-    return _stopwatch.avoid();
+    _suspended_at = _chronometro_impl::_clock::now();
+    _is_suspended = true;
   }
 
-  auto Measure::begin() noexcept -> _iterator
+  void Span::_resume() noexcept
   {
-    _remaining = _iterations;
+    // await_resume is also reached without suspending when await_ready is true or await_suspend declines to
+    if (not _is_suspended) return;
 
-    _stopwatch.start();
-    _stopwatch.reset();
-
-    return _iterator(this);
+    const auto now = _chronometro_impl::_clock::now();
+    _suspended   += std::chrono::duration_cast<std::chrono::nanoseconds>(now - _suspended_at);
+    _is_suspended = false;
+    ++_suspensions;
   }
 
-  auto Measure::end() const noexcept -> _iterator
+  void Span::_cancel() noexcept
   {
-    return _iterator();
+    // the suspension did not happen, neither its interval nor itself are counted
+    _is_suspended = false;
   }
 
-  Measure::~Measure() noexcept
+  std::ostream& operator<<(std::ostream& ostream_, const Span::Times& times_) noexcept
   {
-    if _stz_impl_ABNORMAL(_remaining) _stop();
-  }
+    ostream_ << "active " << _chronometro_impl::_time_as_cstring(_chronometro_impl::_as_time(times_.active));
+    ostream_ << ", suspended " << _chronometro_impl::_time_as_cstring(_chronometro_impl::_as_time(times_.suspended));
+    ostream_ << " over " << times_.suspensions << " suspensions";
 
-  auto Measure::_view() noexcept -> Iteration
+    return ostream_;
+  }
+#endif
+//*///------------------------------------------------------------------------------------------------------------------
+  auto cache_sizes() noexcept -> const CacheSizes&
   {
-    return Iteration(_iterations - _remaining, this);
+    static const CacheSizes sizes = _chronometro_impl::_detect_cache_sizes();
+    return sizes;
   }
-
-  bool Measure::_good() noexcept
+  auto environment(const int cpu_) noexcept -> Environment
   {
-    const auto avoid = _stopwatch.avoid();
+    Environment environment = {-1, {}, -1, -1, -1, 1};
 
-    if _stz_impl_EXPECTED(_remaining)
+#if defined(__linux__)
+    environment.cpu  = (cpu_ >= 0) ? cpu_ : ::sched_getcpu();
+    environment.cpus = static_cast<unsigned>(::sysconf(_SC_NPROCESSORS_ONLN));
+
+    char path[128], text[256];
+
+    std::sprintf(path, "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_governor", environment.cpu);
+    if (_chronometro_impl::_read_file(path, text, sizeof(text)))
     {
-      return true;
+      std::sscanf(text, "%31s", environment.governor);
     }
 
-    const auto duration = _stopwatch.total();
+    if (_chronometro_impl::_read_file("/sys/devices/system/cpu/intel_pstate/no_turbo", text, sizeof(text)))
+    {
+      environment.turbo = (text[0] == '0') ? 1 : 0;
+    }
+    else if (_chronometro_impl::_read_file("/sys/devices/system/cpu/cpufreq/boost", text, sizeof(text)))
+    {
+      environment.turbo = (text[0] == '1') ? 1 : 0;
+    }
 
-    if _stz_impl_EXPECTED(_total_fmt)
+    if (_chronometro_impl::_read_file("/proc/loadavg", text, sizeof(text)))
     {
-      _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
-      io::out() << _chronometro_impl::_total_fmt(duration, _total_fmt, _iterations) << std::endl;
+      environment.load_average = std::strtod(text, nullptr);
     }
 
-    return false;
-  }
+    std::sprintf(path, "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", environment.cpu);
+    cpu_set_t siblings;
+    if (_chronometro_impl::_read_file(path, text, sizeof(text))
+      and _chronometro_impl::_parse_cpu_list(text, siblings) > 1)
+    {
+      CPU_CLR(environment.cpu, &siblings);
 
-  void Measure::_next() noexcept
-  {
-    const auto avoid = _stopwatch.avoid();
-    const auto split = _stopwatch.split();
+      unsigned long long busy[2] = {}, total[2] = {};
+      for (int sample = 0; sample != 2; ++sample)
+      {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+          unsigned long long cpu_busy, cpu_total;
+          if (CPU_ISSET(cpu, &siblings) and _chronometro_impl::_cpu_jiffies(cpu, cpu_busy, cpu_total))
+          {
+            busy[sample]  += cpu_busy;
+            total[sample] += cpu_total;
+          }
+        }
 
-    if (_split_fmt)
-    {
-      _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
-      io::out() << _chronometro_impl::_split_fmt(split, _split_fmt, _iterations - _remaining) << std::endl;
+        if (sample == 0) ::usleep(50000);
+      }
+
+      if (total[1] > total[0])
+      {
+        environment.sibling_load = static_cast<double>(busy[1] - busy[0])/static_cast<double>(total[1] - total[0]);
+      }
+      else
+      {
+        environment.sibling_load = 0;
+      }
     }
+#else
+    environment.cpu = cpu_;
+#endif
 
-    --_remaining;
+    return environment;
   }
 
-  void Measure::_stop() noexcept
+  std::ostream& operator<<(std::ostream& ostream_, const Environment& environment_) noexcept
   {
-    const auto duration = _stopwatch.total();
-    
-    _remaining = 0;
+    ostream_ << "environment: cpu " << environment_.cpu
+      << ", governor " << (environment_.governor[0] ? environment_.governor : "unknown")
+      << ", turbo "    << (environment_.turbo == 1 ? "on" : environment_.turbo == 0 ? "off" : "unknown");
 
-    if _stz_impl_EXPECTED(_total_fmt)
+    if (environment_.sibling_load >= 0)
     {
-      _stz_impl_DECLARE_LOCK(_chronometro_impl::_out_mtx);
-      io::out() << _chronometro_impl::_total_fmt(duration, _total_fmt, _iterations) << std::endl;
+      ostream_ << ", SMT siblings " << static_cast<int>(environment_.sibling_load*100) << "% busy";
     }
-  }
-
-  Measure::Iteration::Iteration(const unsigned current_iteration_, Measure* const measurement_) noexcept
-    : value(current_iteration_)
-    , _measurement(measurement_)
-  {}
-
-  void Measure::Iteration::pause() noexcept
-  {
-    _measurement->pause();
-  }
 
-  void Measure::Iteration::start() noexcept
-  {
-    _measurement->start();
-  }
+    ostream_ << ", load " << environment_.load_average << '/' << environment_.cpus;
 
-  auto Measure::Iteration::avoid() noexcept -> Stopwatch::_guard
-  {
-    return _measurement->avoid();
+    return ostream_;
   }
 //*///------------------------------------------------------------------------------------------------------------------
-# define _stz_impl_IO(NAME, LINK) std::ostream& io::NAME() { static std::ostream NAME(LINK.rdbuf());  return NAME; }
+# define _stz_impl_IO(NAME, LINK) inline std::ostream& io::NAME() { static std::ostream NAME(LINK.rdbuf()); return NAME; }
+#if CHRONOMETRO_LEVEL > 0
   _stz_impl_IO(out, std::cout)
   _stz_impl_IO(dbg, std::clog)
   _stz_impl_IO(wrn, std::cerr)
   _stz_impl_IO(err, std::cerr)
+#else
+  namespace _chronometro_impl
+  {
+    // stream without a buffer, so that output is discarded without <iostream>'s static initialization
+    inline auto _null_stream() -> std::ostream&
+    {
+      static std::ostream null(nullptr);
+      return null;
+    }
+  }
+
+  inline std::ostream& io::out() { return _chronometro_impl::_null_stream(); }
+  inline std::ostream& io::dbg() { return _chronometro_impl::_null_stream(); }
+  inline std::ostream& io::wrn() { return _chronometro_impl::_null_stream(); }
+  inline std::ostream& io::err() { return _chronometro_impl::_null_stream(); }
+#endif
 # undef _stz_impl_IO
 //*///------------------------------------------------------------------------------------------------------------------
 }
@@ -941,6 +5246,181 @@ inline namespace chronometro
 //*///------------------------------------------------------------------------------------------------------------------
 }
 //*///------------------------------------------------------------------------------------------------------------------
+#if defined(CHRONOMETRO_TRACK_ALLOCATIONS)
+namespace stz
+{
+inline namespace chronometro
+{
+  namespace _chronometro_impl
+  {
+    static const bool _allocation_hooks_installed = (_allocation_hooks() = true);
+
+    inline auto _tracked_allocate(const std::size_t size_) noexcept -> void*
+    {
+      auto& counters = _allocation_counters();
+      ++counters.allocs;
+      counters.bytes += size_;
+
+      return std::malloc(size_ ? size_ : 1);
+    }
+
+    // not inlined into operator delete, which would otherwise be seen as freeing memory obtained from operator new
+    _stz_impl_NOINLINE
+    inline void _tracked_deallocate(void* const pointer_) noexcept
+    {
+      if (pointer_ == nullptr) return;
+
+      ++_allocation_counters().frees;
+      std::free(pointer_);
+    }
+
+# if defined(__cpp_aligned_new)
+    inline auto _tracked_allocate_aligned(const std::size_t size_, const std::align_val_t alignment_) noexcept
+      -> void*
+    {
+      auto& counters = _allocation_counters();
+      ++counters.allocs;
+      counters.bytes += size_;
+
+      const auto alignment = static_cast<std::size_t>(alignment_);
+#   if defined(_WIN32)
+      return ::_aligned_malloc(size_ ? size_ : 1, alignment);
+#   else
+      // aligned_alloc requires the size to be a multiple of the alignment
+      return std::aligned_alloc(alignment, size_ ? (size_ + alignment - 1) & ~(alignment - 1) : alignment);
+#   endif
+    }
+
+    _stz_impl_NOINLINE
+    inline void _tracked_deallocate_aligned(void* const pointer_) noexcept
+    {
+      if (pointer_ == nullptr) return;
+
+      ++_allocation_counters().frees;
+#   if defined(_WIN32)
+      ::_aligned_free(pointer_);
+#   else
+      std::free(pointer_);
+#   endif
+    }
+# endif
+  }
+}
+}
+
+void* operator new(const std::size_t size_)
+{
+  void* const pointer = stz::_chronometro_impl::_tracked_allocate(size_);
+  if _stz_impl_ABNORMAL(pointer == nullptr) throw std::bad_alloc();
+  return pointer;
+}
+
+void* operator new[](const std::size_t size_)
+{
+  void* const pointer = stz::_chronometro_impl::_tracked_allocate(size_);
+  if _stz_impl_ABNORMAL(pointer == nullptr) throw std::bad_alloc();
+  return pointer;
+}
+
+void* operator new(const std::size_t size_, const std::nothrow_t&) noexcept
+{
+  return stz::_chronometro_impl::_tracked_allocate(size_);
+}
+
+void* operator new[](const std::size_t size_, const std::nothrow_t&) noexcept
+{
+  return stz::_chronometro_impl::_tracked_allocate(size_);
+}
+
+void operator delete(void* const pointer_) noexcept
+{
+  stz::_chronometro_impl::_tracked_deallocate(pointer_);
+}
+
+void operator delete[](void* const pointer_) noexcept
+{
+  stz::_chronometro_impl::_tracked_deallocate(pointer_);
+}
+
+void operator delete(void* const pointer_, const std::nothrow_t&) noexcept
+{
+  stz::_chronometro_impl::_tracked_deallocate(pointer_);
+}
+
+void operator delete[](void* const pointer_, const std::nothrow_t&) noexcept
+{
+  stz::_chronometro_impl::_tracked_deallocate(pointer_);
+}
+
+# if defined(__cpp_sized_deallocation)
+void operator delete(void* const pointer_, std::size_t) noexcept
+{
+  stz::_chronometro_impl::_tracked_deallocate(pointer_);
+}
+
+void operator delete[](void* const pointer_, std::size_t) noexcept
+{
+  stz::_chronometro_impl::_tracked_deallocate(pointer_);
+}
+# endif
+
+# if defined(__cpp_aligned_new)
+void* operator new(const std::size_t size_, const std::align_val_t alignment_)
+{
+  void* const pointer = stz::_chronometro_impl::_tracked_allocate_aligned(size_, alignment_);
+  if _stz_impl_ABNORMAL(pointer == nullptr) throw std::bad_alloc();
+  return pointer;
+}
+
+void* operator new[](const std::size_t size_, const std::align_val_t alignment_)
+{
+  void* const pointer = stz::_chronometro_impl::_tracked_allocate_aligned(size_, alignment_);
+  if _stz_impl_ABNORMAL(pointer == nullptr) throw std::bad_alloc();
+  return pointer;
+}
+
+void* operator new(const std::size_t size_, const std::align_val_t alignment_, const std::nothrow_t&) noexcept
+{
+  return stz::_chronometro_impl::_tracked_allocate_aligned(size_, alignment_);
+}
+
+void* operator new[](const std::size_t size_, const std::align_val_t alignment_, const std::nothrow_t&) noexcept
+{
+  return stz::_chronometro_impl::_tracked_allocate_aligned(size_, alignment_);
+}
+
+void operator delete(void* const pointer_, std::align_val_t) noexcept
+{
+  stz::_chronometro_impl::_tracked_deallocate_aligned(pointer_);
+}
+
+void operator delete[](void* const pointer_, std::align_val_t) noexcept
+{
+  stz::_chronometro_impl::_tracked_deallocate_aligned(pointer_);
+}
+
+void operator delete(void* const pointer_, std::align_val_t, const std::nothrow_t&) noexcept
+{
+  stz::_chronometro_impl::_tracked_deallocate_aligned(pointer_);
+}
+
+void operator delete[](void* const pointer_, std::align_val_t, const std::nothrow_t&) noexcept
+{
+  stz::_chronometro_impl::_tracked_deallocate_aligned(pointer_);
+}
+
+void operator delete(void* const pointer_, std::size_t, std::align_val_t) noexcept
+{
+  stz::_chronometro_impl::_tracked_deallocate_aligned(pointer_);
+}
+
+void operator delete[](void* const pointer_, std::size_t, std::align_val_t) noexcept
+{
+  stz::_chronometro_impl::_tracked_deallocate_aligned(pointer_);
+}
+# endif
+#endif
+//*///------------------------------------------------------------------------------------------------------------------
 # undef _stz_impl_PRAGMA
 # undef _stz_impl_CLANG_IGNORE
 # undef _stz_impl_LIKELY
@@ -949,9 +5429,14 @@ inline namespace chronometro
 # undef _stz_impl_ABNORMAL
 # undef _stz_impl_NODISCARD
 # undef _stz_impl_NODISCARD_REASON
+# undef _stz_impl_NOINLINE
+# undef _stz_impl_THREADSAFE
 # undef _stz_impl_THREADLOCAL
 # undef _stz_impl_DECLARE_MUTEX
+# undef _stz_impl_MEMBER_MUTEX
 # undef _stz_impl_DECLARE_LOCK
+# undef _stz_impl_TSC
+# undef _stz_impl_COROUTINES
 //*///------------------------------------------------------------------------------------------------------------------
 #else
 #error "stz: Support for ISO C++11 is required."
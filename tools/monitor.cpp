@@ -0,0 +1,42 @@
+// dumps the metrics of a SharedMetrics segment every interval: monitor <path> [interval in ms]
+#include "Chronometro.hpp"
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "usage: " << argv[0] << " <path> [interval in ms]\n";
+    return 1;
+  }
+
+  const auto interval = std::chrono::milliseconds(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000);
+
+  stz::Regulator regulator(interval);
+  while (true)
+  {
+    const auto metrics = stz::SharedMetrics::read(argv[1]);
+
+    if (metrics.empty())
+    {
+      std::cerr << "no metrics in \"" << argv[1] << "\"\n";
+    }
+
+    std::printf("%-47s %12s %12s %12s %12s %12s %12s\n", "name", "counter", "count", "p50 ns", "p99 ns", "max ns",
+      "mean ns");
+    for (const auto& metric : metrics)
+    {
+      const long long mean = metric.count ? metric.sum.count()/static_cast<long long>(metric.count) : 0;
+
+      std::printf("%-47s %12llu %12llu %12lld %12lld %12lld %12lld%s\n", metric.name, metric.counter, metric.count,
+        static_cast<long long>(metric.p50.count()), static_cast<long long>(metric.p99.count()),
+        static_cast<long long>(metric.max.count()), mean, metric.torn ? " (torn)" : "");
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+
+    regulator.wait();
+  }
+}